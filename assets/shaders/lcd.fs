@@ -0,0 +1,22 @@
+#version 330
+
+// Darkens the edges of each Game Boy pixel for a dot-matrix look
+
+in vec2 fragTexCoord;
+in vec4 fragColor;
+
+uniform sampler2D texture0;
+uniform vec4 colDiffuse;
+
+out vec4 finalColor;
+
+const vec2 screenSize = vec2(160.0, 144.0);
+
+void main() {
+  vec2 cell = fract(fragTexCoord * screenSize);
+  float edge = step(0.12, cell.x) * step(0.12, cell.y);
+
+  vec4 texel = texture(texture0, fragTexCoord) * colDiffuse * fragColor;
+
+  finalColor = vec4(texel.rgb * mix(0.8, 1.0, edge), texel.a);
+}
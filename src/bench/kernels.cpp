@@ -0,0 +1,389 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "display/Framebuffer.h"
+#include "display/Kernels.h"
+
+/*
+ * hijo-kernel-bench: times the pixel kernels against plain loops and
+ * against the per-pixel compositing the PPU used to do, checks that they
+ * all agree, and prints nanoseconds per call as JSON. The frame entries
+ * time converting a whole 160x144 frame of shades.
+ *
+ *   hijo-kernel-bench [--iterations N]
+ */
+
+namespace {
+  using namespace hijo;
+
+  constexpr size_t Width = 160;
+  constexpr size_t Tiles = Width / 8;
+  constexpr size_t SpriteCount = 10;
+
+  struct Sprite {
+    int32_t x;
+    uint8_t low;
+    uint8_t high;
+    bool xflip;
+    bool behind;
+    bool obp1;
+  };
+
+  struct Line {
+    uint8_t low[Tiles];
+    uint8_t high[Tiles];
+    std::vector<Sprite> sprites;
+  };
+
+  const std::vector<Pixel> BgColors{Pixels::White, Pixels::LightGray, Pixels::DarkGray, Pixels::Black};
+  const std::vector<Pixel> Sp1Colors{Pixels::White, Pixels::DarkGray, Pixels::LightGray, Pixels::Black};
+  const std::vector<Pixel> Sp2Colors{Pixels::White, Pixels::Black, Pixels::DarkGray, Pixels::LightGray};
+
+  // Bit extraction and vector palette lookups for every pixel, the way the
+  // FIFO composited before the kernels existed
+  void ComposePerPixel(const Line &line, Pixel *out) {
+    for (size_t x = 0; x < Width; x++) {
+      int bit = 7 - static_cast<int>(x % 8);
+
+      uint8_t high = !!(line.low[x / 8] & (1 << bit));
+      uint8_t low = !!(line.high[x / 8] & (1 << bit)) << 1;
+      uint8_t bg = high | low;
+
+      Pixel color = BgColors[bg];
+
+      for (const auto &sprite: line.sprites) {
+        int32_t offset = static_cast<int32_t>(x) - sprite.x;
+
+        if (offset < 0 || offset > 7)
+          continue;
+
+        int spriteBit = sprite.xflip ? offset : 7 - offset;
+
+        uint8_t spriteColor = (!!(sprite.low & (1 << spriteBit))) | ((!!(sprite.high & (1 << spriteBit))) << 1);
+
+        if (!spriteColor)
+          continue;
+
+        if (!sprite.behind || bg == 0) {
+          color = sprite.obp1 ? Sp2Colors[spriteColor] : Sp1Colors[spriteColor];
+          break;
+        }
+      }
+
+      out[x] = color;
+    }
+  }
+
+  struct Composer {
+    Pixel palette[12];
+
+    uint8_t shades[4] = {0, 2, 1, 3};
+
+    Composer() {
+      for (size_t i = 0; i < 4; i++) {
+        palette[i] = BgColors[i];
+        palette[4 + i] = Sp1Colors[i];
+        palette[8 + i] = Sp2Colors[i];
+      }
+    }
+
+    void operator()(const Line &line, Pixel *out) {
+      uint8_t background[Width];
+      uint8_t front[Width + 8]{};
+      uint8_t any[Width + 8]{};
+      uint8_t merged[Width];
+
+      for (size_t tile = 0; tile < Tiles; tile++) {
+        Kernels::DecodeRow(line.low[tile], line.high[tile], background + tile * 8);
+      }
+
+      for (const auto &sprite: line.sprites) {
+        uint8_t row[8];
+        uint8_t palette = sprite.obp1 ? 2 : 1;
+
+        Kernels::DecodeRow(sprite.low, sprite.high, row);
+
+        if (sprite.xflip) {
+          std::reverse(row, row + 8);
+        }
+
+        for (int32_t offset = 0; offset < 8; offset++) {
+          int32_t x = sprite.x + offset;
+
+          if (x < 0 || x >= static_cast<int32_t>(Width) || !row[offset])
+            continue;
+
+          uint8_t pixel = (palette << 2) | row[offset];
+
+          if (!any[x])
+            any[x] = pixel;
+
+          if (!sprite.behind && !front[x])
+            front[x] = pixel;
+        }
+      }
+
+      Kernels::MergeSprites(background, true, front, any, merged, Width);
+      Kernels::ResolvePalette(merged, palette, out, Width);
+    }
+  };
+
+  template<typename Fn>
+  double Time(uint32_t iterations, Fn &&fn) {
+    auto start = std::chrono::steady_clock::now();
+
+    for (uint32_t i = 0; i < iterations; i++) {
+      fn(i);
+    }
+
+    auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+  }
+
+  bool Same(const Pixel *a, const Pixel *b, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+      if (a[i].r != b[i].r || a[i].g != b[i].g || a[i].b != b[i].b || a[i].a != b[i].a) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+}
+
+int main(int argc, char **argv) {
+  uint32_t iterations = 200000;
+
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+
+    if (arg == "--iterations" && i + 1 < argc) {
+      iterations = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else {
+      std::fprintf(stderr, "usage: hijo-kernel-bench [--iterations N]\n");
+      return 1;
+    }
+  }
+
+  if (!iterations) {
+    iterations = 1;
+  }
+
+  std::mt19937 rng(0x4849);
+  auto byte = [&rng]() { return static_cast<uint8_t>(rng()); };
+
+  // A handful of lines and tiles to cycle through so nothing is constant
+  constexpr size_t Samples = 64;
+
+  std::vector<Line> lines(Samples);
+  std::vector<uint8_t> tiles(Samples * 16);
+
+  for (auto &line: lines) {
+    for (size_t tile = 0; tile < Tiles; tile++) {
+      line.low[tile] = byte();
+      line.high[tile] = byte();
+    }
+
+    for (size_t i = 0; i < SpriteCount; i++) {
+      line.sprites.push_back({static_cast<int32_t>(rng() % (Width + 8)) - 8, byte(), byte(),
+                              (rng() & 1) != 0, (rng() & 3) == 0, (rng() & 1) != 0});
+    }
+
+    std::stable_sort(line.sprites.begin(), line.sprites.end(), [](const Sprite &a, const Sprite &b) {
+      return a.x < b.x;
+    });
+  }
+
+  for (auto &value: tiles) {
+    value = byte();
+  }
+
+  // Check every variant against the per-pixel path first
+  bool agree = true;
+  Composer compose;
+
+  for (const auto &line: lines) {
+    Pixel expected[Width];
+    Pixel actual[Width];
+
+    ComposePerPixel(line, expected);
+    compose(line, actual);
+
+    agree = agree && Same(expected, actual, Width);
+  }
+
+  for (size_t sample = 0; sample < Samples; sample++) {
+    uint8_t expected[64];
+    uint8_t actual[64];
+
+    Kernels::Scalar::DecodeTile(&tiles[sample * 16], expected);
+    Kernels::DecodeTile(&tiles[sample * 16], actual);
+
+    agree = agree && std::equal(expected, expected + 64, actual);
+  }
+
+  uint8_t background[Width];
+  uint8_t front[Width];
+  uint8_t any[Width];
+
+  for (size_t i = 0; i < Width; i++) {
+    background[i] = byte() & 3;
+    front[i] = (rng() % 3) ? 0 : 4 + (byte() % 8);
+    any[i] = front[i] ? front[i] : ((rng() % 3) ? 0 : 4 + (byte() % 8));
+  }
+
+  {
+    uint8_t expected[Width];
+    uint8_t actual[Width];
+
+    Kernels::Scalar::MergeSprites(background, true, front, any, expected, Width);
+    Kernels::MergeSprites(background, true, front, any, actual, Width);
+    agree = agree && std::equal(expected, expected + Width, actual);
+
+    Pixel expectedPixels[Width];
+    Pixel actualPixels[Width];
+
+    Kernels::Scalar::ResolvePalette(expected, compose.palette, expectedPixels, Width);
+    Kernels::ResolvePalette(expected, compose.palette, actualPixels, Width);
+    agree = agree && Same(expectedPixels, actualPixels, Width);
+  }
+
+  // A frame of shades and the conversions a front-end would ask for
+  std::vector<uint8_t> shades(Framebuffer::Size);
+  uint16_t colors565[4] = {0xFFFF, 0xAD55, 0x52AA, 0x0000};
+
+  for (auto &shade: shades) {
+    shade = byte() & 3;
+  }
+
+  {
+    std::vector<uint8_t> expected(Framebuffer::Size);
+    std::vector<uint8_t> actual(Framebuffer::Size);
+
+    Kernels::Scalar::MapIndices(shades.data(), compose.shades, expected.data(), Framebuffer::Size);
+    Kernels::MapIndices(shades.data(), compose.shades, 4, actual.data(), Framebuffer::Size);
+    agree = agree && expected == actual;
+
+    std::vector<uint16_t> expected565(Framebuffer::Size);
+    std::vector<uint16_t> actual565(Framebuffer::Size);
+
+    Kernels::Scalar::ResolveRGB565(shades.data(), colors565, expected565.data(), Framebuffer::Size);
+    Kernels::ResolveRGB565(shades.data(), colors565, 4, actual565.data(), Framebuffer::Size);
+    agree = agree && expected565 == actual565;
+  }
+
+  // Keeps the results alive
+  uint32_t sink = 0;
+
+  Pixel pixels[Width];
+  uint8_t decoded[64];
+  uint8_t merged[Width];
+
+  auto perPixelLine = Time(iterations, [&](uint32_t i) {
+    ComposePerPixel(lines[i % Samples], pixels);
+    sink += pixels[i % Width].r;
+  });
+
+  auto kernelLine = Time(iterations, [&](uint32_t i) {
+    compose(lines[i % Samples], pixels);
+    sink += pixels[i % Width].r;
+  });
+
+  auto perPixelDecode = Time(iterations, [&](uint32_t i) {
+    const uint8_t *tile = &tiles[(i % Samples) * 16];
+
+    for (int row = 0; row < 8; row++) {
+      for (int bit = 7; bit >= 0; bit--) {
+        uint8_t high = !!(tile[row * 2] & (1 << bit));
+        uint8_t low = !!(tile[row * 2 + 1] & (1 << bit)) << 1;
+
+        decoded[row * 8 + (7 - bit)] = high | low;
+      }
+    }
+
+    sink += decoded[i % 64];
+  });
+
+  auto scalarDecode = Time(iterations, [&](uint32_t i) {
+    Kernels::Scalar::DecodeTile(&tiles[(i % Samples) * 16], decoded);
+    sink += decoded[i % 64];
+  });
+
+  auto simdDecode = Time(iterations, [&](uint32_t i) {
+    Kernels::DecodeTile(&tiles[(i % Samples) * 16], decoded);
+    sink += decoded[i % 64];
+  });
+
+  auto scalarMerge = Time(iterations, [&](uint32_t i) {
+    background[i % Width] ^= 1;
+    Kernels::Scalar::MergeSprites(background, true, front, any, merged, Width);
+    sink += merged[i % Width];
+  });
+
+  auto simdMerge = Time(iterations, [&](uint32_t i) {
+    background[i % Width] ^= 1;
+    Kernels::MergeSprites(background, true, front, any, merged, Width);
+    sink += merged[i % Width];
+  });
+
+  auto scalarResolve = Time(iterations, [&](uint32_t i) {
+    merged[i % Width] = (merged[i % Width] + 1) % 12;
+    Kernels::Scalar::ResolvePalette(merged, compose.palette, pixels, Width);
+    sink += pixels[i % Width].g;
+  });
+
+  auto simdResolve = Time(iterations, [&](uint32_t i) {
+    merged[i % Width] = (merged[i % Width] + 1) % 12;
+    Kernels::ResolvePalette(merged, compose.palette, pixels, Width);
+    sink += pixels[i % Width].g;
+  });
+
+  std::vector<Pixel> frame(Framebuffer::Size);
+  std::vector<uint16_t> frame565(Framebuffer::Size);
+  std::vector<uint8_t> frameGray(Framebuffer::Size);
+
+  auto toRGBA = Time(iterations / 100 + 1, [&](uint32_t i) {
+    shades[i % Framebuffer::Size] ^= 1;
+    Kernels::ResolvePalette(shades.data(), compose.palette, frame.data(), Framebuffer::Size);
+    sink += frame[i % Framebuffer::Size].b;
+  });
+
+  auto toRGB565 = Time(iterations / 100 + 1, [&](uint32_t i) {
+    shades[i % Framebuffer::Size] ^= 1;
+    Kernels::ResolveRGB565(shades.data(), colors565, 4, frame565.data(), Framebuffer::Size);
+    sink += frame565[i % Framebuffer::Size];
+  });
+
+  auto toGray = Time(iterations / 100 + 1, [&](uint32_t i) {
+    shades[i % Framebuffer::Size] ^= 1;
+    Kernels::MapIndices(shades.data(), compose.shades, 4, frameGray.data(), Framebuffer::Size);
+    sink += frameGray[i % Framebuffer::Size];
+  });
+
+  std::string report = "{\n";
+
+  report += fmt::format("  \"isa\": \"{}\",\n", Kernels::InstructionSet());
+  report += fmt::format("  \"iterations\": {},\n", iterations);
+  report += fmt::format("  \"agree\": {},\n", agree);
+  report += fmt::format("  \"line\": {{\"perPixel\": {:.1f}, \"kernels\": {:.1f}}},\n", perPixelLine, kernelLine);
+  report += fmt::format("  \"decodeTile\": {{\"perPixel\": {:.1f}, \"scalar\": {:.1f}, \"simd\": {:.1f}}},\n",
+                        perPixelDecode, scalarDecode, simdDecode);
+  report += fmt::format("  \"mergeSprites\": {{\"scalar\": {:.1f}, \"simd\": {:.1f}}},\n", scalarMerge, simdMerge);
+  report += fmt::format("  \"resolvePalette\": {{\"scalar\": {:.1f}, \"simd\": {:.1f}}},\n", scalarResolve, simdResolve);
+  report += fmt::format("  \"frame\": {{\"rgba\": {:.1f}, \"rgb565\": {:.1f}, \"gray\": {:.1f}}},\n",
+                        toRGBA, toRGB565, toGray);
+  report += fmt::format("  \"checksum\": {}\n", sink);
+  report += "}\n";
+
+  std::fputs(report.c_str(), stdout);
+
+  return agree ? 0 : 1;
+}
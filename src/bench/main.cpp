@@ -0,0 +1,427 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+#include <spdlog/sinks/stdout_color_sinks.h>
+
+#include "cartridge/BatteryRam.h"
+#include "core/events/EventManager.h"
+#include "system/Gameboy.h"
+#include "system/Profiler.h"
+
+/*
+ * hijo-bench: runs a ROM for a number of frames as fast as the host allows,
+ * without a window or an audio device, and prints the results as JSON.
+ *
+ *   hijo-bench <rom>... [--frames N] [--warmup N] [--input script]
+ *              [--profile] [--jit] [--block-cache] [--idle-loops]
+ *              [--scanline] [--mapped-saves] [--output file]
+ *
+ * With more than one ROM each runs in turn with the same options, the
+ * report lists every run under "runs" and sums up the halted cycles over
+ * all of them.
+ *
+ * An input script holds one "<frame> <button> <press|release>" per line,
+ * buttons being a, b, start, select, up, down, left and right. Lines
+ * starting with # are ignored. Frames count from the first warmup frame.
+ */
+
+namespace {
+  using namespace hijo;
+
+  // 4194304 Hz / 70224 T-cycles per frame
+  constexpr double FramesPerSecond = 59.7275;
+
+  struct Options {
+    std::vector<std::string> roms;
+    std::string input;
+    std::string output;
+    uint32_t frames = 3600;
+    uint32_t warmup = 0;
+    bool profile = false;
+    bool jit = false;
+    bool blockCache = false;
+    bool idleLoops = false;
+    bool scanline = false;
+    bool mappedSaves = false;
+  };
+
+  struct InputEvent {
+    uint32_t frame;
+    Controller::Button button;
+    bool pressed;
+  };
+
+  void Usage() {
+    std::fprintf(stderr,
+                 "usage: hijo-bench <rom>... [--frames N] [--warmup N] [--input script]\n"
+                 "                  [--profile] [--jit] [--block-cache] [--idle-loops]\n"
+                 "                  [--scanline] [--mapped-saves] [--output file]\n");
+  }
+
+  bool ParseOptions(int argc, char **argv, Options &options) {
+    for (int i = 1; i < argc; i++) {
+      std::string arg = argv[i];
+
+      auto value = [&](std::string &out) {
+        if (i + 1 >= argc) {
+          return false;
+        }
+
+        out = argv[++i];
+        return true;
+      };
+
+      auto number = [&](uint32_t &out) {
+        std::string text;
+
+        if (!value(text)) {
+          return false;
+        }
+
+        char *end = nullptr;
+        out = static_cast<uint32_t>(std::strtoul(text.c_str(), &end, 10));
+
+        return end != text.c_str() && *end == '\0';
+      };
+
+      bool ok = true;
+
+      if (arg == "--frames") {
+        ok = number(options.frames);
+      } else if (arg == "--warmup") {
+        ok = number(options.warmup);
+      } else if (arg == "--input") {
+        ok = value(options.input);
+      } else if (arg == "--output") {
+        ok = value(options.output);
+      } else if (arg == "--profile") {
+        options.profile = true;
+      } else if (arg == "--jit") {
+        options.jit = true;
+      } else if (arg == "--block-cache") {
+        options.blockCache = true;
+      } else if (arg == "--idle-loops") {
+        options.idleLoops = true;
+      } else if (arg == "--scanline") {
+        options.scanline = true;
+      } else if (arg == "--mapped-saves") {
+        options.mappedSaves = true;
+      } else if (!arg.empty() && arg[0] != '-') {
+        options.roms.push_back(arg);
+      } else {
+        ok = false;
+      }
+
+      if (!ok) {
+        return false;
+      }
+    }
+
+    return !options.roms.empty() && options.frames > 0;
+  }
+
+  bool ParseButton(const std::string &name, Controller::Button &button) {
+    static const std::pair<const char *, Controller::Button> buttons[] = {
+        {"a",      Controller::Button::A},
+        {"b",      Controller::Button::B},
+        {"start",  Controller::Button::Start},
+        {"select", Controller::Button::Select},
+        {"up",     Controller::Button::Up},
+        {"down",   Controller::Button::Down},
+        {"left",   Controller::Button::Left},
+        {"right",  Controller::Button::Right}
+    };
+
+    for (const auto &[label, value]: buttons) {
+      if (name == label) {
+        button = value;
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  bool LoadInputScript(const std::string &path, std::vector<InputEvent> &events) {
+    std::ifstream stream(path);
+
+    if (!stream) {
+      spdlog::get("console")->error("Couldn't open input script {}", path);
+      return false;
+    }
+
+    std::string line;
+    uint32_t lineNumber = 0;
+
+    while (std::getline(stream, line)) {
+      lineNumber++;
+
+      if (line.empty() || line[0] == '#') {
+        continue;
+      }
+
+      char button[16]{};
+      char action[16]{};
+      uint32_t frame = 0;
+
+      InputEvent event{};
+
+      if (std::sscanf(line.c_str(), "%u %15s %15s", &frame, button, action) != 3 ||
+          !ParseButton(button, event.button) ||
+          (std::string(action) != "press" && std::string(action) != "release")) {
+        spdlog::get("console")->error("{}:{}: expected \"<frame> <button> <press|release>\"", path, lineNumber);
+        return false;
+      }
+
+      event.frame = frame;
+      event.pressed = std::string(action) == "press";
+
+      events.push_back(event);
+    }
+
+    std::stable_sort(events.begin(), events.end(), [](const InputEvent &a, const InputEvent &b) {
+      return a.frame < b.frame;
+    });
+
+    return true;
+  }
+
+  // FNV-1a over the shades of the last frame, for spotting output changes
+  uint64_t FrameHash(const Framebuffer &frame) {
+    uint64_t hash = 14695981039346656037ull;
+
+    for (size_t i = 0; i < Framebuffer::Size; i++) {
+      hash ^= frame.Data()[i];
+      hash *= 1099511628211ull;
+    }
+
+    return hash;
+  }
+
+  std::string Escape(const std::string &text) {
+    std::string escaped;
+
+    for (char c: text) {
+      switch (c) {
+        case '"':
+          escaped += "\\\"";
+          break;
+        case '\\':
+          escaped += "\\\\";
+          break;
+        case '\n':
+          escaped += "\\n";
+          break;
+        default:
+          if (static_cast<unsigned char>(c) < 0x20) {
+            escaped += fmt::format("\\u{:04x}", c);
+          } else {
+            escaped += c;
+          }
+          break;
+      }
+    }
+
+    return escaped;
+  }
+
+  // Emulated M-cycles over every ROM run so far
+  struct Totals {
+    uint64_t cycles = 0;
+    uint64_t halted = 0;
+    uint64_t skipped = 0;
+  };
+
+  // skippedShare is the part of all emulated cycles HALT fast-forwarded
+  // over instead of stepping
+  std::string HaltReport(uint64_t halted, uint64_t skipped, uint64_t cycles) {
+    return fmt::format("{{\"mcycles\": {}, \"skipped\": {}, \"skippedShare\": {:.4f}}}",
+                       halted, skipped, cycles ? static_cast<double>(skipped) / cycles : 0.0);
+  }
+
+  // Runs one ROM with the options and returns its report
+  std::string Run(const Options &options, const std::string &rom, const std::vector<InputEvent> &script,
+                  Totals &totals) {
+    auto &gb = Gameboy::Get();
+    auto &cpu = gb.Cpu();
+    auto &profiler = Profiler::Get();
+
+    EventManager::Dispatcher().trigger(Events::LoadROM{rom});
+
+    cpu.UseBlockCache(options.blockCache);
+    cpu.UseJit(options.jit);
+    cpu.UseIdleLoopSkip(options.idleLoops);
+    gb.Video().UseScanlineRenderer(options.scanline);
+
+    const double timestep = 1.0 / FramesPerSecond;
+    size_t nextInput = 0;
+
+    auto runFrame = [&](uint32_t frame) {
+      while (nextInput < script.size() && script[nextInput].frame <= frame) {
+        gb.Joypad().SetButton(script[nextInput].button, script[nextInput].pressed);
+        nextInput++;
+      }
+
+      gb.Update(timestep);
+    };
+
+    for (uint32_t frame = 0; frame < options.warmup; frame++) {
+      runFrame(frame);
+    }
+
+    uint64_t startInstructions = cpu.InstructionCount();
+    uint64_t startCycles = gb.TotalCycles();
+    auto startHalt = cpu.GetHaltStats();
+    auto startIdle = cpu.IdleLoopStats();
+
+    profiler.Enable(options.profile);
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (uint32_t frame = options.warmup; frame < options.warmup + options.frames; frame++) {
+      runFrame(frame);
+    }
+
+    auto end = std::chrono::steady_clock::now();
+
+    profiler.Flush();
+
+    auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    double seconds = static_cast<double>(nanoseconds) / 1e9;
+    uint64_t instructions = cpu.InstructionCount() - startInstructions;
+    uint64_t cycles = gb.TotalCycles() - startCycles;
+    const auto &halt = cpu.GetHaltStats();
+    const auto &idle = cpu.IdleLoopStats();
+    uint64_t halted = halt.cycles - startHalt.cycles;
+    uint64_t skipped = halt.skipped - startHalt.skipped;
+    double fps = options.frames / seconds;
+
+    totals.cycles += cycles;
+    totals.halted += halted;
+    totals.skipped += skipped;
+
+    std::string report = "{\n";
+
+    report += fmt::format("  \"rom\": \"{}\",\n", Escape(rom));
+    report += fmt::format("  \"frames\": {},\n", options.frames);
+    report += fmt::format("  \"warmup\": {},\n", options.warmup);
+    report += fmt::format("  \"inputEvents\": {},\n", script.size());
+    report += fmt::format("  \"options\": {{\"jit\": {}, \"blockCache\": {}, \"idleLoops\": {}, \"scanline\": {}, \"profile\": {}}},\n",
+                          cpu.UsingJit(), cpu.UsingBlockCache(), cpu.UsingIdleLoopSkip(),
+                          gb.Video().UsingScanlineRenderer(), options.profile);
+    report += fmt::format("  \"seconds\": {:.6f},\n", seconds);
+    report += fmt::format("  \"fps\": {:.2f},\n", fps);
+    report += fmt::format("  \"speed\": {:.2f},\n", fps / FramesPerSecond);
+    report += fmt::format("  \"nsPerFrame\": {:.0f},\n", static_cast<double>(nanoseconds) / options.frames);
+    report += fmt::format("  \"instructions\": {},\n", instructions);
+    report += fmt::format("  \"mips\": {:.3f},\n", instructions / seconds / 1e6);
+    report += fmt::format("  \"mcycles\": {},\n", cycles);
+    report += fmt::format("  \"halt\": {},\n", HaltReport(halted, skipped, cycles));
+    report += fmt::format("  \"idleLoops\": {{\"skips\": {}, \"elided\": {}}},\n",
+                          idle.skips - startIdle.skips, idle.skippedCycles - startIdle.skippedCycles);
+    report += fmt::format("  \"frameHash\": \"{:016x}\"", FrameHash(gb.VideoBuffer()));
+
+    if (options.profile) {
+      static const std::pair<const char *, Profiler::Section> sections[] = {
+          {"cpu",    Profiler::Section::CPU},
+          {"ppu",    Profiler::Section::PPU},
+          {"apu",    Profiler::Section::APU},
+          {"mapper", Profiler::Section::Mapper}
+      };
+
+      uint64_t profiled = 0;
+
+      for (const auto &[label, section]: sections) {
+        profiled += profiler.Nanoseconds(section);
+      }
+
+      report += ",\n  \"breakdown\": {";
+
+      for (size_t i = 0; i < std::size(sections); i++) {
+        auto spent = profiler.Nanoseconds(sections[i].second);
+
+        report += fmt::format("{}\"{}\": {{\"ns\": {}, \"percent\": {:.1f}}}",
+                              i ? ", " : "", sections[i].first, spent,
+                              profiled ? 100.0 * spent / profiled : 0.0);
+      }
+
+      report += "}";
+    }
+
+    report += "\n}";
+
+    return report;
+  }
+}
+
+int main(int argc, char **argv) {
+  // Keep stdout for the report
+  spdlog::stderr_color_mt("console");
+
+  Options options;
+
+  if (!ParseOptions(argc, argv, options)) {
+    Usage();
+    return 1;
+  }
+
+  for (const auto &rom: options.roms) {
+    if (!std::ifstream(rom)) {
+      spdlog::get("console")->error("Couldn't open ROM {}", rom);
+      return 1;
+    }
+  }
+
+  std::vector<InputEvent> script;
+
+  if (!options.input.empty() && !LoadInputScript(options.input, script)) {
+    return 1;
+  }
+
+  BatteryRam::UseMappedFiles(options.mappedSaves);
+
+  Totals totals;
+  std::string report;
+
+  if (options.roms.size() == 1) {
+    report = Run(options, options.roms[0], script, totals) + "\n";
+  } else {
+    report = "{\n  \"runs\": [\n";
+
+    for (size_t i = 0; i < options.roms.size(); i++) {
+      auto run = Run(options, options.roms[i], script, totals);
+
+      // Nest the run's lines one level deeper
+      std::string nested = "    ";
+
+      for (char c: run) {
+        nested += c;
+
+        if (c == '\n') {
+          nested += "    ";
+        }
+      }
+
+      report += nested + (i + 1 < options.roms.size() ? ",\n" : "\n");
+    }
+
+    report += "  ],\n";
+    report += fmt::format("  \"mcycles\": {},\n", totals.cycles);
+    report += fmt::format("  \"halt\": {}\n", HaltReport(totals.halted, totals.skipped, totals.cycles));
+    report += "}\n";
+  }
+
+  if (options.output.empty()) {
+    std::fputs(report.c_str(), stdout);
+  } else {
+    std::ofstream(options.output) << report;
+  }
+
+  return 0;
+}
@@ -0,0 +1,216 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "cartridge/Cartridge.h"
+#include "cartridge/mappers/ROM.h"
+#include "cartridge/mappers/MBC1.h"
+#include "cartridge/mappers/MBC2.h"
+#include "cartridge/mappers/MBC3.h"
+#include "cartridge/mappers/MBC5.h"
+
+/*
+ * hijo-mapper-bench: runs the same stream of cartridge accesses through
+ * each mapper twice, once through Cartridge::Read/Write and the virtual
+ * Mapper calls behind them and once through Cartridge::Read/Write<TMapper>
+ * the bus uses, checks that both see the same bytes and prints nanoseconds
+ * per access as JSON. The ROMs are built on the fly in
+ * the temp directory.
+ *
+ *   hijo-mapper-bench [--iterations N]
+ */
+
+namespace {
+  using namespace hijo;
+
+  constexpr uint16_t RomBanks = 64;
+  constexpr uint8_t RamBanks = 4;
+
+  constexpr size_t StreamLength = 4096;
+  constexpr int Rounds = 5;
+
+  struct Op {
+    uint16_t addr;
+    uint8_t data;
+    bool write;
+  };
+
+  template<typename Fn>
+  double Time(uint32_t iterations, Fn &&fn) {
+    auto start = std::chrono::steady_clock::now();
+
+    for (uint32_t i = 0; i < iterations; i++) {
+      fn(i);
+    }
+
+    auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+  }
+
+  // Writes a ROM for the given cartridge type, every byte holding its bank
+  // number so reads tell whether switching worked
+  std::string MakeRom(const std::string &name, uint8_t type) {
+    std::vector<char> bytes(RomBanks * 0x4000);
+
+    for (size_t i = 0; i < bytes.size(); i++) {
+      bytes[i] = static_cast<char>(i / 0x4000);
+    }
+
+    bytes[0x147] = static_cast<char>(type);
+    bytes[0x148] = 0x05; // 1 MiB, 64 banks
+    bytes[0x149] = 0x03; // 32 KiB, 4 banks
+
+    auto path = (std::filesystem::temp_directory_path() / fmt::format("hijo-mapper-bench-{}.gb", name)).string();
+
+    std::ofstream file(path, std::ios::binary);
+    file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+
+    return path;
+  }
+
+  // Mostly banked ROM and RAM reads, with bank switches and RAM writes
+  // mixed in the way a game's inner loop would
+  std::vector<Op> MakeStream(size_t count) {
+    std::mt19937 rng(0x4849);
+    std::vector<Op> ops;
+
+    ops.push_back({0x0000, 0x0A, true});
+
+    while (ops.size() < count) {
+      auto kind = rng() % 16;
+      auto offset = static_cast<uint16_t>(rng());
+
+      if (kind == 0) {
+        ops.push_back({0x2100, static_cast<uint8_t>(1 + rng() % (RomBanks - 1)), true});
+      } else if (kind == 1) {
+        ops.push_back({0x4000, static_cast<uint8_t>(rng() % RamBanks), true});
+      } else if (kind < 4) {
+        ops.push_back({static_cast<uint16_t>(0xA000 | (offset & 0x1FF)), static_cast<uint8_t>(rng()), true});
+      } else if (kind < 7) {
+        ops.push_back({static_cast<uint16_t>(0xA000 | (offset & 0x1FF)), 0, false});
+      } else {
+        ops.push_back({static_cast<uint16_t>(offset & 0x7FFF), 0, false});
+      }
+    }
+
+    return ops;
+  }
+
+  struct Result {
+    double virtualCall;
+    double specialized;
+    bool agree;
+  };
+
+  template<typename TMapper>
+  Result Measure(const std::vector<Op> &ops, uint32_t iterations, const std::string &name, uint8_t type,
+                 uint32_t &sink) {
+    auto path = MakeRom(name, type);
+
+    // Two cartridges so each path starts from the same state
+    auto cartridge = Cartridge::Load(path);
+    auto specialized = Cartridge::Load(path);
+
+    uint32_t virtualSum = 0;
+    uint32_t specializedSum = 0;
+
+    auto virtualCall = [&]() {
+      return Time(iterations, [&](uint32_t i) {
+        const auto &op = ops[i & (StreamLength - 1)];
+
+        if (op.write) {
+          cartridge->Write(op.addr, op.data);
+        } else {
+          virtualSum = virtualSum * 31 + cartridge->Read(op.addr);
+        }
+      });
+    };
+
+    auto specializedCall = [&]() {
+      return Time(iterations, [&](uint32_t i) {
+        const auto &op = ops[i & (StreamLength - 1)];
+
+        if (op.write) {
+          specialized->Write<TMapper>(op.addr, op.data);
+        } else {
+          specializedSum = specializedSum * 31 + specialized->Read<TMapper>(op.addr);
+        }
+      });
+    };
+
+    // Rounds alternate between the two so neither gets a warmer machine,
+    // the best round of each counts
+    double virtualBest = virtualCall();
+    double specializedBest = specializedCall();
+
+    for (int round = 1; round < Rounds; round++) {
+      virtualBest = std::min(virtualBest, virtualCall());
+      specializedBest = std::min(specializedBest, specializedCall());
+    }
+
+    sink += virtualSum + specializedSum;
+
+    std::filesystem::remove(path);
+
+    return {virtualBest, specializedBest, virtualSum == specializedSum};
+  }
+}
+
+int main(int argc, char **argv) {
+  uint32_t iterations = 1000000;
+
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+
+    if (arg == "--iterations" && i + 1 < argc) {
+      iterations = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else {
+      std::fprintf(stderr, "usage: hijo-mapper-bench [--iterations N]\n");
+      return 1;
+    }
+  }
+
+  if (!iterations) {
+    iterations = 1;
+  }
+
+  auto ops = MakeStream(StreamLength);
+
+  // Keeps the results alive
+  uint32_t sink = 0;
+  bool agree = true;
+
+  std::string report = "{\n";
+
+  report += fmt::format("  \"iterations\": {},\n", iterations);
+
+  auto add = [&](const char *name, const Result &result) {
+    agree = agree && result.agree;
+    report += fmt::format("  \"{}\": {{\"virtual\": {:.2f}, \"specialized\": {:.2f}}},\n",
+                          name, result.virtualCall, result.specialized);
+  };
+
+  add("ROM", Measure<ROM>(ops, iterations, "rom", 0x00, sink));
+  add("MBC1", Measure<MBC1>(ops, iterations, "mbc1", 0x02, sink));
+  add("MBC2", Measure<MBC2>(ops, iterations, "mbc2", 0x05, sink));
+  add("MBC3", Measure<MBC3>(ops, iterations, "mbc3", 0x12, sink));
+  add("MBC5", Measure<MBC5>(ops, iterations, "mbc5", 0x1A, sink));
+
+  report += fmt::format("  \"agree\": {},\n", agree);
+  report += fmt::format("  \"checksum\": {}\n", sink);
+  report += "}\n";
+
+  std::fputs(report.c_str(), stdout);
+
+  return agree ? 0 : 1;
+}
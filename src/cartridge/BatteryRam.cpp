@@ -0,0 +1,259 @@
+#include "BatteryRam.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <spdlog/spdlog.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define HIJO_SAVE_MMAP 1
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace hijo {
+
+  namespace {
+    std::atomic<bool> s_UseMappedFiles = false;
+
+    // The writer can still be running while the app tears its loggers down
+    template<typename... Args>
+    void Warn(fmt::format_string<Args...> format, Args &&...args) {
+      if (auto console = spdlog::get("console")) {
+        console->warn(format, std::forward<Args>(args)...);
+      }
+    }
+  }
+
+  BatteryRam::BatteryRam(const std::string &path, size_t size, ReplaceHook onReplace)
+      : m_Path(path), m_OnReplace(std::move(onReplace)), m_Size(size), m_Dirty((size + PageSize - 1) / PageSize, 0) {
+    if (!s_UseMappedFiles || !MapFile()) {
+      ReadFile();
+      m_Pending.assign(m_Data, m_Data + m_Size);
+    }
+
+    m_PendingPages.assign(m_Dirty.size(), 0);
+    m_Writer = std::thread(&BatteryRam::Run, this);
+  }
+
+  BatteryRam::~BatteryRam() {
+    Flush();
+
+    {
+      std::lock_guard<std::mutex> lock(m_Lock);
+      m_Stop = true;
+    }
+
+    m_Wake.notify_one();
+    m_Writer.join();
+
+#ifdef HIJO_SAVE_MMAP
+    if (m_Mapped) {
+      ::munmap(m_Data, m_Size);
+    }
+#endif
+  }
+
+  void BatteryRam::UseMappedFiles(bool enabled) {
+    s_UseMappedFiles = enabled;
+  }
+
+  void BatteryRam::Flush() {
+    if (!m_HasDirty) {
+      return;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(m_Lock);
+
+      for (size_t page = 0; page < m_Dirty.size(); page++) {
+        if (!m_Dirty[page]) {
+          continue;
+        }
+
+        m_Dirty[page] = 0;
+
+        if (m_Mapped) {
+          m_PendingPages[page] = 1;
+        } else {
+          size_t start = page * PageSize;
+          std::memcpy(&m_Pending[start], m_Data + start, std::min(PageSize, m_Size - start));
+        }
+      }
+
+      m_Requested = true;
+    }
+
+    m_HasDirty = false;
+    m_Wake.notify_one();
+  }
+
+  void BatteryRam::Tick(double timestep) {
+    m_Elapsed += timestep;
+
+    if (m_Elapsed >= FlushInterval) {
+      m_Elapsed = 0;
+      Flush();
+    }
+  }
+
+  void BatteryRam::ReadFile() {
+    m_Buffer = CartRam(m_Size);
+    m_Data = m_Buffer.Data();
+
+    std::ifstream ramFile(m_Path, std::ios::binary);
+
+    if (!ramFile) {
+      spdlog::get("console")->warn("Couldn't open save file for loading!");
+      return;
+    }
+
+    ramFile.read(reinterpret_cast<char *>(m_Data), static_cast<std::streamsize>(m_Size));
+  }
+
+  void BatteryRam::Run() {
+    std::vector<uint8_t> work;
+    std::unique_lock<std::mutex> lock(m_Lock);
+
+    while (true) {
+      m_Wake.wait(lock, [this] { return m_Requested || m_Stop; });
+
+      if (!m_Requested) {
+        break;
+      }
+
+      m_Requested = false;
+
+      if (m_Mapped) {
+        work = m_PendingPages;
+        std::fill(m_PendingPages.begin(), m_PendingPages.end(), 0);
+      } else {
+        work = m_Pending;
+      }
+
+      lock.unlock();
+
+      if (m_Mapped) {
+        SyncPages(work);
+      } else {
+        WriteFile(work);
+      }
+
+      lock.lock();
+    }
+  }
+
+  bool BatteryRam::WriteFile(const std::vector<uint8_t> &image) {
+    auto temp = m_Path + ".tmp";
+    auto *file = std::fopen(temp.c_str(), "wb");
+
+    if (!file) {
+      Warn("Couldn't open save file for saving!");
+      return false;
+    }
+
+    bool written = std::fwrite(image.data(), 1, image.size(), file) == image.size() && std::fflush(file) == 0;
+
+#ifdef HIJO_SAVE_MMAP
+    // The new contents have to be on disk before the rename can expose them
+    written = written && ::fsync(fileno(file)) == 0;
+#endif
+
+    written = std::fclose(file) == 0 && written;
+
+    if (!written) {
+      Warn("Couldn't write save file {}", temp);
+      std::remove(temp.c_str());
+      return false;
+    }
+
+    if (m_OnReplace) {
+      m_OnReplace(temp);
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temp, m_Path, error);
+
+    if (error) {
+      Warn("Couldn't replace save file {}: {}", m_Path, error.message());
+      return false;
+    }
+
+    return true;
+  }
+
+#ifdef HIJO_SAVE_MMAP
+  bool BatteryRam::MapFile() {
+    if (m_Size == 0) {
+      return false;
+    }
+
+    int fd = ::open(m_Path.c_str(), O_RDWR | O_CREAT, 0644);
+
+    if (fd < 0) {
+      return false;
+    }
+
+    struct stat info{};
+
+    if (::fstat(fd, &info) != 0 ||
+        (static_cast<size_t>(info.st_size) < m_Size && ::ftruncate(fd, static_cast<off_t>(m_Size)) != 0)) {
+      ::close(fd);
+      return false;
+    }
+
+    void *memory = ::mmap(nullptr, m_Size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+
+    if (memory == MAP_FAILED) {
+      Warn("Couldn't map save file {}, saving through copies", m_Path);
+      return false;
+    }
+
+    m_Data = static_cast<uint8_t *>(memory);
+    m_Mapped = true;
+
+    return true;
+  }
+
+  void BatteryRam::SyncPages(const std::vector<uint8_t> &pages) {
+    auto systemPage = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+
+    // msync wants whole system pages, runs of dirty pages go out together
+    for (size_t page = 0; page < pages.size();) {
+      if (!pages[page]) {
+        page++;
+        continue;
+      }
+
+      size_t end = page;
+
+      while (end < pages.size() && pages[end]) {
+        end++;
+      }
+
+      size_t start = (page * PageSize) & ~(systemPage - 1);
+      size_t stop = std::min(end * PageSize, m_Size);
+
+      if (::msync(m_Data + start, stop - start, MS_SYNC) != 0) {
+        Warn("Couldn't sync save file {}", m_Path);
+      }
+
+      page = end;
+    }
+  }
+#else
+  bool BatteryRam::MapFile() {
+    return false;
+  }
+
+  void BatteryRam::SyncPages(const std::vector<uint8_t> &) {}
+#endif
+
+} // hijo
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cartridge/CartRam.h"
+
+namespace hijo {
+
+  // Battery backed cartridge RAM as it goes to <rom>.sav. The mapper uses
+  // the image as its RAM and reports each write, which only marks the
+  // 256-byte page dirty. A writer
+  // thread takes the dirty pages to disk when the game disables RAM, every
+  // FlushInterval seconds of emulation and when the cartridge goes away.
+  //
+  // The file is replaced by writing <rom>.sav.tmp and renaming it over the
+  // save, so a crash mid-flush leaves the previous save intact. With mapped
+  // files the image is the .sav itself and a flush is an msync of the dirty
+  // pages: cheaper, but a crash can leave a mix of old and new pages.
+  class BatteryRam {
+  public:
+    static constexpr size_t PageSize = 0x100;
+    static constexpr double FlushInterval = 1.0;
+
+    // Runs on the writer thread once <rom>.sav.tmp is complete, before it
+    // replaces the save. Lets tests look at what a crash there would leave.
+    using ReplaceHook = std::function<void(const std::string &temp)>;
+
+  public:
+    BatteryRam(const std::string &path, size_t size, ReplaceHook onReplace = {});
+
+    ~BatteryRam();
+
+    BatteryRam(const BatteryRam &) = delete;
+
+    BatteryRam &operator=(const BatteryRam &) = delete;
+
+    // Applies to saves opened from then on
+    static void UseMappedFiles(bool enabled);
+
+    // The save as loaded, zero filled past the end of a short or missing
+    // file. Page aligned either way.
+    uint8_t *Data() const {
+      return m_Data;
+    }
+
+    size_t Size() const {
+      return m_Size;
+    }
+
+    bool Mapped() const {
+      return m_Mapped;
+    }
+
+    bool Dirty() const {
+      return m_HasDirty;
+    }
+
+    void MarkDirty(size_t offset) {
+      m_Dirty[offset / PageSize] = 1;
+      m_HasDirty = true;
+    }
+
+    // Hands the dirty pages to the writer thread
+    void Flush();
+
+    void Tick(double timestep);
+
+  private:
+    bool MapFile();
+
+    void ReadFile();
+
+    void Run();
+
+    bool WriteFile(const std::vector<uint8_t> &image);
+
+    void SyncPages(const std::vector<uint8_t> &pages);
+
+  private:
+    std::string m_Path;
+    ReplaceHook m_OnReplace;
+
+    uint8_t *m_Data = nullptr;
+    size_t m_Size = 0;
+    bool m_Mapped = false;
+
+    CartRam m_Buffer;
+
+    std::vector<uint8_t> m_Dirty;
+    bool m_HasDirty = false;
+
+    double m_Elapsed = 0;
+
+    // Shared with the writer thread: the file's next contents, or the pages
+    // to msync when mapped
+    std::mutex m_Lock;
+    std::condition_variable m_Wake;
+    std::vector<uint8_t> m_Pending;
+    std::vector<uint8_t> m_PendingPages;
+    bool m_Requested = false;
+    bool m_Stop = false;
+
+    std::thread m_Writer;
+  };
+
+} // hijo
@@ -0,0 +1,40 @@
+#include "CartRam.h"
+
+#include <cstring>
+#include <new>
+#include <utility>
+
+namespace hijo {
+
+  CartRam::CartRam(size_t size) : m_Size(size) {
+    if (m_Size > 0) {
+      m_Data = static_cast<uint8_t *>(::operator new(m_Size, std::align_val_t(Alignment)));
+      std::memset(m_Data, 0, m_Size);
+    }
+  }
+
+  CartRam::~CartRam() {
+    Release();
+  }
+
+  CartRam::CartRam(CartRam &&other) noexcept
+      : m_Data(std::exchange(other.m_Data, nullptr)), m_Size(std::exchange(other.m_Size, 0)) {}
+
+  CartRam &CartRam::operator=(CartRam &&other) noexcept {
+    if (this != &other) {
+      Release();
+      m_Data = std::exchange(other.m_Data, nullptr);
+      m_Size = std::exchange(other.m_Size, 0);
+    }
+
+    return *this;
+  }
+
+  void CartRam::Release() {
+    if (m_Data) {
+      ::operator delete(m_Data, std::align_val_t(Alignment));
+      m_Data = nullptr;
+    }
+  }
+
+} // hijo
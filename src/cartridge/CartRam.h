@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace hijo {
+
+  // Cartridge RAM as one zeroed block, page aligned so the bus page table,
+  // a file mapping or a save state can take it as is. Banks sit back to
+  // back, bank n starts at n * BankSize.
+  class CartRam {
+  public:
+    static constexpr size_t BankSize = 0x2000;
+    static constexpr size_t Alignment = 0x1000;
+
+  public:
+    CartRam() = default;
+
+    explicit CartRam(size_t size);
+
+    ~CartRam();
+
+    CartRam(CartRam &&other) noexcept;
+
+    CartRam &operator=(CartRam &&other) noexcept;
+
+    CartRam(const CartRam &) = delete;
+
+    CartRam &operator=(const CartRam &) = delete;
+
+    uint8_t *Data() const {
+      return m_Data;
+    }
+
+    size_t Size() const {
+      return m_Size;
+    }
+
+  private:
+    void Release();
+
+  private:
+    uint8_t *m_Data = nullptr;
+    size_t m_Size = 0;
+  };
+
+} // hijo
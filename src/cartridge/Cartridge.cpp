@@ -1,12 +1,12 @@
 #include "Cartridge.h"
 
-#include <fstream>
 #include <spdlog/spdlog.h>
 
 #include "mappers/ROM.h"
 #include "mappers/MBC1.h"
 #include "mappers/MBC2.h"
 #include "mappers/MBC3.h"
+#include "mappers/MBC5.h"
 
 namespace hijo {
   std::unique_ptr<Cartridge> Cartridge::Load(const std::string &path) {
@@ -16,55 +16,46 @@ namespace hijo {
   Cartridge::Cartridge(const std::string &path) {
     m_Path = path;
 
-    std::ifstream stream(path.c_str(), std::ios::binary | std::ios::ate);
+    m_Rom = RomImage::Open(path);
 
-    if (!stream.good()) {
+    if (!m_Rom) {
       // TODO: Do something here
       return;
     }
 
-    auto position = stream.tellg();
-    auto fileSize = static_cast<size_t>(position);
-
-    std::vector<char> contents(fileSize);
-
-    stream.seekg(0, std::ios::beg);
-    stream.read(&contents[0], static_cast<std::streamsize>(position));
-    stream.close();
-
-    m_Data = std::vector<uint8_t>(contents.begin(), contents.end());
-
     LoadHeader();
     LoadMapper();
   }
 
   void Cartridge::LoadHeader() {
-    if (m_Data.size() >= 0x0150) {
+    const auto &rom = *m_Rom;
+
+    if (rom.Size() >= 0x0150) {
       m_Header.title.clear();
 
       for (auto i = 0x134; i < 0x143; i++)
-        if (m_Data[i])
-          m_Header.title.push_back(m_Data[i]);
+        if (rom[i])
+          m_Header.title.push_back(rom[i]);
 
-      m_Header.CGBFlag = m_Data[0x143];
+      m_Header.CGBFlag = rom[0x143];
 
       m_Header.newLicenseeCode.clear();
       for (auto i = 0x144; i < 0x146; i++)
-        m_Header.newLicenseeCode.push_back((char) m_Data[i]);
-
-      m_Header.sgbFlag = m_Data[0x146];
-      m_Header.cartridgeType = m_Data[0x147];
-      m_Header.romSize = m_Data[0x148];
-      m_Header.ramSize = m_Data[0x149];
-      m_Header.destinationCode = m_Data[0x14A];
-      m_Header.licenseeCode = m_Data[0x14B];
-      m_Header.maskRomVersion = m_Data[0x14C];
-      m_Header.headerChecksum = m_Data[0x14D];
+        m_Header.newLicenseeCode.push_back((char) rom[i]);
+
+      m_Header.sgbFlag = rom[0x146];
+      m_Header.cartridgeType = rom[0x147];
+      m_Header.romSize = rom[0x148];
+      m_Header.ramSize = rom[0x149];
+      m_Header.destinationCode = rom[0x14A];
+      m_Header.licenseeCode = rom[0x14B];
+      m_Header.maskRomVersion = rom[0x14C];
+      m_Header.headerChecksum = rom[0x14D];
       m_Header.globalChecksum = 0;
 
       uint16_t x = 0;
       for (uint16_t i = 0x0134; i <= 0x014C; i++) {
-        x = x - m_Data[i] - 1;
+        x = x - rom[i] - 1;
       }
 
       m_Header.headerChecksumPassed = x & 0xFF;
@@ -101,52 +92,67 @@ namespace hijo {
     m_Mapper->Write(addr, data);
   }
 
+  uint16_t Cartridge::RomBank() const {
+    return m_Mapper->RomBank();
+  }
+
+  std::span<uint8_t> Cartridge::Ram() const {
+    return m_Mapper ? m_Mapper->Ram() : std::span<uint8_t>{};
+  }
+
+  void Cartridge::Attach(MemoryMap &map) {
+    if (m_Mapper) {
+      m_Mapper->Attach(&map);
+    }
+  }
+
   void Cartridge::LoadMapper() {
-    switch (m_Header.mapperInfo.type) {
+    m_MapperType = m_Header.mapperInfo.type;
+
+    switch (m_MapperType) {
       case Mapper::Type::ROM:
         m_Mapper = std::make_unique<ROM>(m_Path);
-        m_Mapper->SetRomData(m_Data);
         break;
 
       case Mapper::Type::MBC1:
         m_Mapper = std::make_unique<MBC1>(m_Path);
-        m_Mapper->SetRomData(m_Data);
-        m_Mapper->SetRomBanks(m_Header.romInfo.romBankCount);
-        m_Mapper->SetRamBanks(m_Header.ramInfo.ramBankCount);
         break;
 
       case Mapper::Type::MBC2:
         m_Mapper = std::make_unique<MBC2>(m_Path);
-        m_Mapper->SetRomData(m_Data);
-        m_Mapper->SetRomBanks(m_Header.romInfo.romBankCount);
-        m_Mapper->SetRamBanks(0);
         break;
 
       case Mapper::Type::MBC3:
         m_Mapper = std::make_unique<MBC3>(m_Path);
-        m_Mapper->SetRomData(m_Data);
-        m_Mapper->SetRomBanks(m_Header.romInfo.romBankCount);
-        m_Mapper->SetRamBanks(m_Header.ramInfo.ramBankCount);
+        break;
+
+      case Mapper::Type::MBC5:
+        m_Mapper = std::make_unique<MBC5>(m_Path);
         break;
 
       default:
         m_Mapper = std::make_unique<ROM>(m_Path);
-        m_Mapper->SetRomData(m_Data);
+        m_MapperType = Mapper::Type::ROM;
         spdlog::get("console")->warn("Unsupported Mapper type: {}, using ROM mapper.", m_Header.cartridgeType);
         break;
     }
 
-    if (m_Mapper) {
-      m_Mapper->SetFeatures(m_Header.mapperInfo.hasRam,
-                            m_Header.mapperInfo.hasBattery,
-                            m_Header.mapperInfo.hasTimer,
-                            m_Header.mapperInfo.hasRumble);
-    }
+    m_Mapper->SetRomData(m_Rom);
+
+    // Features first, RAM setup needs to know about the battery
+    m_Mapper->SetFeatures(m_Header.mapperInfo.hasRam,
+                          m_Header.mapperInfo.hasBattery,
+                          m_Header.mapperInfo.hasTimer,
+                          m_Header.mapperInfo.hasRumble);
+
+    m_Mapper->SetRomBanks(m_Header.romInfo.romBankCount);
+    m_Mapper->SetRamBanks(m_Header.ramInfo.ramBankCount);
   }
 
   void Cartridge::Tick(double timestep) {
     if (m_Mapper) {
       m_Mapper->Tick(timestep);
+      m_Mapper->TickBattery(timestep);
     }
   }
 
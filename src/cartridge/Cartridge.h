@@ -5,7 +5,9 @@
 #include <vector>
 #include <map>
 #include <memory>
+#include <span>
 
+#include "RomImage.h"
 #include "mappers/Mapper.h"
 
 namespace hijo {
@@ -56,8 +58,9 @@ namespace hijo {
       RamSizeInfo ramInfo;
     };
   public:
-    std::vector<uint8_t> &Data() {
-      return m_Data;
+    // Null when the file couldn't be opened
+    const RomImage *Rom() const {
+      return m_Rom.get();
     }
 
   public:
@@ -68,6 +71,32 @@ namespace hijo {
 
     void Write(uint16_t addr, uint8_t data);
 
+    // Read/Write on the concrete mapper, without the virtual call. TMapper
+    // has to be the class MapperType() names.
+    template<typename TMapper>
+    uint8_t Read(uint16_t addr) {
+      return static_cast<TMapper &>(*m_Mapper).TMapper::Read(addr);
+    }
+
+    template<typename TMapper>
+    void Write(uint16_t addr, uint8_t data) {
+      static_cast<TMapper &>(*m_Mapper).TMapper::Write(addr, data);
+    }
+
+    // Picked from the header once, by LoadMapper. Unsupported types fall
+    // back to the ROM mapper and report ROM here.
+    Mapper::Type MapperType() const {
+      return m_MapperType;
+    }
+
+    uint16_t RomBank() const;
+
+    // Cartridge RAM as one block, empty when the cartridge has none
+    std::span<uint8_t> Ram() const;
+
+    // Lets the mapper serve ROM and RAM banks straight from the bus page table
+    void Attach(MemoryMap &map);
+
     void Tick(double timestep);
 
     const HeaderData &Header() const {
@@ -86,8 +115,9 @@ namespace hijo {
 
   private:
     HeaderData m_Header;
-    std::vector<uint8_t> m_Data;
+    std::shared_ptr<const RomImage> m_Rom;
     std::unique_ptr<Mapper> m_Mapper;
+    Mapper::Type m_MapperType = Mapper::Type::NONE;
     std::string m_Path;
 
     std::map<std::string, std::string> m_NewLicenseeMap = {
@@ -0,0 +1,145 @@
+#include "RomImage.h"
+
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <tuple>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define HIJO_ROM_MMAP 1
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace hijo {
+
+#ifdef HIJO_ROM_MMAP
+  namespace {
+    // Device, inode, size and modification time, so a ROM rebuilt in place
+    // gets a fresh image instead of the one still held by the old cartridge
+    using FileKey = std::tuple<uint64_t, uint64_t, uint64_t, int64_t, int64_t>;
+
+    std::mutex s_ImagesLock;
+    std::map<FileKey, std::weak_ptr<const RomImage>> s_Images;
+
+    FileKey KeyOf(const struct stat &info) {
+#ifdef __APPLE__
+      const auto &modified = info.st_mtimespec;
+#else
+      const auto &modified = info.st_mtim;
+#endif
+
+      return {static_cast<uint64_t>(info.st_dev), static_cast<uint64_t>(info.st_ino),
+              static_cast<uint64_t>(info.st_size), modified.tv_sec, modified.tv_nsec};
+    }
+  }
+
+  std::shared_ptr<const RomImage> RomImage::Open(const std::string &path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+
+    if (fd < 0) {
+      return nullptr;
+    }
+
+    struct stat info{};
+
+    if (::fstat(fd, &info) != 0) {
+      ::close(fd);
+      return nullptr;
+    }
+
+    auto key = KeyOf(info);
+
+    std::lock_guard<std::mutex> lock(s_ImagesLock);
+
+    if (auto it = s_Images.find(key); it != s_Images.end()) {
+      if (auto image = it->second.lock()) {
+        ::close(fd);
+        return image;
+      }
+    }
+
+    std::shared_ptr<RomImage> image(new RomImage());
+    bool loaded = image->Map(fd, static_cast<size_t>(info.st_size));
+
+    // The mapping stays valid once the descriptor is closed
+    ::close(fd);
+
+    if (!loaded && !image->Read(path)) {
+      return nullptr;
+    }
+
+    std::erase_if(s_Images, [](const auto &entry) {
+      return entry.second.expired();
+    });
+
+    s_Images[key] = image;
+
+    return image;
+  }
+
+  bool RomImage::Map(int fd, size_t size) {
+    if (size == 0) {
+      return true;
+    }
+
+    void *memory = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    if (memory == MAP_FAILED) {
+      return false;
+    }
+
+    m_Data = static_cast<const uint8_t *>(memory);
+    m_Size = size;
+    m_Mapped = true;
+
+    return true;
+  }
+
+  RomImage::~RomImage() {
+    if (m_Mapped) {
+      ::munmap(const_cast<uint8_t *>(m_Data), m_Size);
+    }
+  }
+#else
+  std::shared_ptr<const RomImage> RomImage::Open(const std::string &path) {
+    std::shared_ptr<RomImage> image(new RomImage());
+
+    if (!image->Read(path)) {
+      return nullptr;
+    }
+
+    return image;
+  }
+
+  bool RomImage::Map(int, size_t) {
+    return false;
+  }
+
+  RomImage::~RomImage() = default;
+#endif
+
+  bool RomImage::Read(const std::string &path) {
+    std::ifstream stream(path.c_str(), std::ios::binary | std::ios::ate);
+
+    if (!stream.good()) {
+      return false;
+    }
+
+    auto position = stream.tellg();
+
+    m_Buffer.resize(static_cast<size_t>(position));
+
+    stream.seekg(0, std::ios::beg);
+    stream.read(reinterpret_cast<char *>(m_Buffer.data()), static_cast<std::streamsize>(position));
+
+    m_Data = m_Buffer.data();
+    m_Size = m_Buffer.size();
+
+    return true;
+  }
+
+} // hijo
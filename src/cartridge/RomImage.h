@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace hijo {
+
+  // A ROM file mapped read-only into memory. Cartridges and mappers borrow it
+  // through a shared_ptr instead of keeping copies, and every Gameboy that
+  // opens the same file while an image is alive gets that same image, so a
+  // host running many instances of one game keeps a single set of pages.
+  class RomImage {
+  public:
+    // Returns nullptr when the file can't be opened
+    static std::shared_ptr<const RomImage> Open(const std::string &path);
+
+    ~RomImage();
+
+    RomImage(const RomImage &) = delete;
+
+    RomImage &operator=(const RomImage &) = delete;
+
+    const uint8_t *Data() const {
+      return m_Data;
+    }
+
+    size_t Size() const {
+      return m_Size;
+    }
+
+    uint8_t operator[](size_t offset) const {
+      return m_Data[offset];
+    }
+
+  private:
+    RomImage() = default;
+
+    bool Map(int fd, size_t size);
+
+    bool Read(const std::string &path);
+
+  private:
+    const uint8_t *m_Data = nullptr;
+    size_t m_Size = 0;
+
+    bool m_Mapped = false;
+
+    // Backing store on platforms without mmap
+    std::vector<uint8_t> m_Buffer;
+  };
+
+} // hijo
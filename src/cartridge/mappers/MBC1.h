@@ -1,10 +1,12 @@
+#pragma once
+
 #include "Mapper.h"
 
 #include <vector>
 
 namespace hijo {
 
-  class MBC1 : public Mapper {
+  class MBC1 final : public Mapper {
   public:
     MBC1(const std::string &path) : Mapper(path) {}
 
@@ -18,18 +20,19 @@ namespace hijo {
 
     std::vector<StatLine> GetStats() override;
 
-  private:
-    void SaveRam();
+    uint16_t RomBank() const override;
 
-    void LoadRam();
+  protected:
+    void MapPages() override;
 
+  private:
     void SetRomBank(uint8_t value);
 
     void SetRamBank(uint8_t value);
 
-  private:
-    std::vector<std::vector<uint8_t>> m_RamBanks;
+    void UpdateRamBank();
 
+  private:
     uint16_t m_RomBankCount;
     uint8_t m_RamBankCount;
 
@@ -43,7 +46,22 @@ namespace hijo {
 
     uint32_t m_RomBankBase = 0;
 
-    bool m_NeedsSave = false;
+    // Follow the bank registers so reads skip the bank arithmetic,
+    // m_RamBank is null while RAM is disabled
+    const uint8_t *m_RomBank = nullptr;
+    uint8_t *m_RamBank = nullptr;
   };
 
+  inline uint8_t MBC1::Read(uint16_t addr) {
+    if (addr < 0x4000) {
+      return m_Data[addr];
+    }
+
+    if (addr < 0x8000) {
+      return m_RomBank[addr - 0x4000];
+    }
+
+    return m_RamBank ? m_RamBank[addr - 0xA000] : 0xFF;
+  }
+
 } // hijo
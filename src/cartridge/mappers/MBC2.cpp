@@ -2,27 +2,8 @@
 #include "MBC2.h"
 
 #include <fmt/format.h>
-#include <spdlog/spdlog.h>
 
 namespace hijo {
-  uint8_t MBC2::Read(uint16_t addr) {
-    uint16_t addrEnd = (m_RomBankCount == 2) ? 0x8000 : 0x4000;
-
-    if (addr < addrEnd) {
-      return m_Data[addr];
-    }
-
-    if ((addr & 0xE000) == 0xA000) {
-      if (!m_RamEnabled) {
-        return 0x0F;
-      }
-
-      return m_Ram[addr & 0x1FF] & 0xF;
-    }
-
-    return m_Data[m_RomBankBase + (addr - 0x4000)];
-  }
-
   void MBC2::Write(uint16_t addr, uint8_t data) {
     if (addr < 0x4000) {
       bool bit8 = (((addr & 0xFF00) >> 8) & 1) == 1;
@@ -38,11 +19,12 @@ namespace hijo {
         // Enable/Disable RAM
         m_RamEnabled = data == 0x0A;
 
-        if (!m_RamEnabled) {
-          SaveRam();
+        if (!m_RamEnabled && m_Battery) {
+          m_Battery->Flush();
         }
       }
 
+      UpdatePages();
       return;
     }
 
@@ -52,19 +34,29 @@ namespace hijo {
 
       m_Ram[addr & 0x1FF] = data & 0xF;
 
-      SaveRam();
+      if (m_Battery) {
+        m_Battery->MarkDirty(addr & 0x1FF);
+      }
     }
   }
 
-  void MBC2::SetRomData(std::vector<uint8_t> &data) {
-    m_Data = data;
-  }
-
   void MBC2::SetRomBanks(uint16_t bankCount) {
     m_RomBankCount = bankCount;
     SetRomBank(1);
   }
   
+  uint16_t MBC2::RomBank() const {
+    return m_RomBankBase / 0x4000;
+  }
+
+  void MBC2::MapPages() {
+    MapRomBank(0x0000, 0);
+    MapRomBank(0x4000, m_RomBankBase);
+
+    // RAM is 512 half-bytes, always through Read/Write
+    m_Map->Unmap(0xA000, 0x2000);
+  }
+
   std::vector<Mapper::StatLine> MBC2::GetStats() {
     std::vector<StatLine> lines;
 
@@ -74,44 +66,21 @@ namespace hijo {
     lines.push_back({"Selected Rom Bank", fmt::format("{}", m_RomBankValue)});
 
     lines.push_back({"Rom Bank Base", fmt::format("0x{:04X}", m_RomBankBase)});
-    lines.push_back({"Needs Save?", m_NeedsSave ? "Yes" : "No"});
+    lines.push_back({"Needs Save?", m_Battery && m_Battery->Dirty() ? "Yes" : "No"});
 
     return lines;
   }
 
   void MBC2::SetRomBank(uint8_t value) {
-    m_RomBankValue = value % m_RomBankCount;
-    m_RomBankBase = 0x4000 * value;
-  }
-
-  void MBC2::SaveRam() {
-    std::ofstream ramFile(fmt::format("{}.sav", path), std::ios::out | std::ios::binary);
-
-    if (!ramFile) {
-      spdlog::get("console")->warn("Couldn't open save file for saving!");
-      return;
-    }
-
-    ramFile.write(reinterpret_cast<const char *>(&m_Ram[0]), 512);
-
-    ramFile.close();
-  }
-
-  void MBC2::LoadRam() {
-    std::ifstream ramFile(fmt::format("{}.sav", path), std::ios::binary);
-
-    if (!ramFile) {
-      spdlog::get("console")->warn("Couldn't open save file for loading!");
-      return;
-    }
-
-    std::vector<uint8_t> buffer(std::istreambuf_iterator<char>(ramFile), {});
-    m_Ram = buffer;
+    m_RomBankValue = WrapRomBank(value, m_RomBankCount);
 
-    ramFile.close();
+    // 32k ROMs have no banking, 0x4000 always shows bank 1
+    m_RomBankBase = 0x4000 * (m_RomBankCount == 2 ? 1 : m_RomBankValue);
+    m_RomBank = m_Data + m_RomBankBase;
   }
 
   void MBC2::SetRamBanks(uint8_t) {
-    LoadRam();
+    // 512 half-bytes built into the MBC, only the low nibble is read back
+    OpenRam(RamSize);
   }
 } // hijo
\ No newline at end of file
@@ -6,7 +6,7 @@
 
 namespace hijo {
 
-  class MBC2 : public Mapper {
+  class MBC2 final : public Mapper {
   public:
     MBC2(const std::string &path) : Mapper(path) {}
 
@@ -14,24 +14,24 @@ namespace hijo {
 
     void Write(uint16_t addr, uint8_t data) override;
 
-    void SetRomData(std::vector<uint8_t> &data) override;
-
     void SetRomBanks(uint16_t bankCount) override;
 
     void SetRamBanks(uint8_t uint8) override;
 
     std::vector<StatLine> GetStats() override;
 
-  private:
-    void SetRomBank(uint8_t value);
+    uint16_t RomBank() const override;
 
-    void SaveRam();
+  protected:
+    void MapPages() override;
 
-    void LoadRam();
+  private:
+    static constexpr size_t RamSize = 0x200;
 
   private:
-    std::vector<uint8_t> m_Ram = std::vector<uint8_t>(512);
+    void SetRomBank(uint8_t value);
 
+  private:
     uint16_t m_RomBankCount;
 
     bool m_RamEnabled = false;
@@ -41,8 +41,25 @@ namespace hijo {
     uint8_t m_RomBankValue = 0;
     uint32_t m_RomBankBase = 0;
 
-    bool m_NeedsSave = false;
+    // Follows the bank register so reads skip the bank arithmetic
+    const uint8_t *m_RomBank = nullptr;
   };
 
+  inline uint8_t MBC2::Read(uint16_t addr) {
+    if (addr < 0x4000) {
+      return m_Data[addr];
+    }
+
+    if (addr < 0x8000) {
+      return m_RomBank[addr - 0x4000];
+    }
+
+    if (!m_RamEnabled) {
+      return 0x0F;
+    }
+
+    return m_Ram[addr & 0x1FF] & 0xF;
+  }
+
 } // hijo
 
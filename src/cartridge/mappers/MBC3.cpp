@@ -2,55 +2,22 @@
 
 #include "common/common.h"
 #include <fmt/format.h>
-#include <spdlog/spdlog.h>
 
 #include "system/Gameboy.h"
 
 namespace hijo {
-  uint8_t MBC3::Read(uint16_t addr) {
-    uint16_t addrEnd = (m_RomBankCount == 2) ? 0x8000 : 0x4000;
-
-    if (addr < addrEnd) {
-      return m_Data[addr];
-    }
-
-    if ((addr & 0xE000) == 0xA000) {
-      if (!m_RamEnabled) {
-        return 0xFF;
-      }
-
-      if (m_RTCBanked) {
-        switch (m_SelectedField) {
-          case RTCField::Seconds:
-            return m_RTC.seconds;
-          case RTCField::Minutes:
-            return m_RTC.minutes;
-          case RTCField::Hours:
-            return m_RTC.hours;
-          case RTCField::DayLow:
-            return (m_RTC.day & 0xFF00) >> 8;
-          case RTCField::DayHigh:
-            return m_RTC.day & 0xFF;
-        }
-      }
-
-      if (m_RamBanks.size() == 0 || m_RamBankValue >= m_RamBanks.size()) {
-        return 0xFF;
-      }
-
-      return m_RamBanks[m_RamBankValue][addr - 0xA000];
-    }
-
-    return m_Data[m_RomBankBase + (addr - 0x4000)];
-  }
-
   void MBC3::Write(uint16_t addr, uint8_t data) {
     if (addr < 0x2000) {
       m_RamEnabled = ((data & 0xF) == 0xA);
       if (!m_RamEnabled) {
         m_RTCBanked = false;
-        // EventManager::Dispatcher().trigger(Events::SaveRam{});
+
+        if (m_Battery) {
+          m_Battery->Flush();
+        }
       }
+
+      UpdateRamBank();
     }
 
     switch (addr & 0xE000) {
@@ -103,12 +70,8 @@ namespace hijo {
 
         // RAM Write
       case 0xA000:
-        if (!m_RamEnabled)
-          return;
-
-        if (m_RamBanks.size() == 0 || m_RamBankValue >= m_RamBanks.size()) {
+        if (!m_RamBank)
           return;
-        }
 
         if (m_RTCBanked) {
           switch (m_SelectedField) {
@@ -140,13 +103,17 @@ namespace hijo {
           }
         }
 
-        m_RamBanks[m_RamBankValue][addr - 0xA000] = data;
+        m_RamBank[addr - 0xA000] = data;
 
-        if (m_HasBattery) {
-          SaveRam();
+        if (m_Battery) {
+          m_Battery->MarkDirty((m_RamBank - m_Ram) + (addr - 0xA000));
         }
         break;
     }
+
+    if (addr < 0x8000) {
+      UpdatePages();
+    }
   }
 
   void MBC3::SetRomBanks(uint16_t bankCount) {
@@ -155,17 +122,27 @@ namespace hijo {
   }
 
   void MBC3::SetRamBanks(uint8_t bankCount) {
-    m_RamBanks.clear();
     m_RamBankCount = bankCount;
+    OpenRam(m_RamBankCount * CartRam::BankSize);
 
-    if (m_RamBankCount > 0) {
-      for (uint8_t i = 0; i < m_RamBankCount; i++) {
-        std::vector<uint8_t> bank(0x2000);
-        m_RamBanks.push_back(bank);
-      }
-    }
+    UpdateRamBank();
+  }
+
+  uint16_t MBC3::RomBank() const {
+    return m_RomBankBase / 0x4000;
+  }
 
-    LoadRam();
+  void MBC3::MapPages() {
+    MapRomBank(0x0000, 0);
+    MapRomBank(0x4000, m_RomBankBase);
+
+    if (m_RamBank && !m_RTCBanked) {
+      // Battery backed RAM is written through Write, so the save sees it
+      m_Map->MapRead(0xA000, 0x2000, m_RamBank);
+      m_Map->MapWrite(0xA000, 0x2000, m_Battery ? nullptr : m_RamBank);
+    } else {
+      m_Map->Unmap(0xA000, 0x2000);
+    }
   }
 
   std::vector<Mapper::StatLine> MBC3::GetStats() {
@@ -183,7 +160,7 @@ namespace hijo {
     lines.push_back({"Selected Ram Bank", fmt::format("{}", m_RamBankValue)});
 
     lines.push_back({"Rom Bank Base", fmt::format("0x{:04X}", m_RomBankBase)});
-    lines.push_back({"Needs Save?", m_NeedsSave ? "Yes" : "No"});
+    lines.push_back({"Needs Save?", m_Battery && m_Battery->Dirty() ? "Yes" : "No"});
 
     lines.push_back({"Shadow RTC - Seconds", fmt::format("{}", m_ShadowRTC.seconds)});
     lines.push_back({"Shadow RTC - Minutes", fmt::format("{}", m_ShadowRTC.minutes)});
@@ -207,7 +184,6 @@ namespace hijo {
                      fmt::format("{}",
                                  Bit((m_RTC.day & 0xFF00) >> 8, 7) ? "Yes" : "No")});
 
-
     return lines;
   }
 
@@ -251,49 +227,23 @@ namespace hijo {
   }
 
   void MBC3::SetRomBank(uint8_t value) {
-    m_RomBankValue = value % m_RomBankCount;
-    m_RomBankBase = 0x4000 * value;
+    m_RomBankValue = WrapRomBank(value, m_RomBankCount);
+
+    // 32k ROMs have no banking, 0x4000 always shows bank 1
+    m_RomBankBase = 0x4000 * (m_RomBankCount == 2 ? 1 : m_RomBankValue);
+    m_RomBank = m_Data + m_RomBankBase;
   }
 
   void MBC3::SetRamBank(uint8_t value) {
     m_RamBankValue = value;
+    UpdateRamBank();
   }
 
-  void MBC3::SaveRam() {
-    if (m_RamBankCount == 0)
-      return;
-
-    std::ofstream ramFile(fmt::format("{}.sav", path), std::ios::out | std::ios::binary);
-
-    if (!ramFile) {
-      spdlog::get("console")->warn("Couldn't open save file for saving!");
-      return;
-    }
-
-    for (auto n = 0; n < m_RamBankCount; n++) {
-      auto &bank = m_RamBanks[n];
-      ramFile.write(reinterpret_cast<const char *>(&bank[0]), 0x2000);
-    }
-
-    ramFile.close();
-  }
-
-  void MBC3::LoadRam() {
-    if (m_RamBankCount == 0)
-      return;
-
-    std::ifstream ramFile(fmt::format("{}.sav", path), std::ios::binary);
-
-    if (!ramFile) {
-      spdlog::get("console")->warn("Couldn't open save file for loading!");
-      return;
-    }
-
-    for (auto n = 0; n < m_RamBankCount; n++) {
-      std::vector<uint8_t> buffer(std::istreambuf_iterator<char>(ramFile), {});
-      m_RamBanks[n] = buffer;
+  void MBC3::UpdateRamBank() {
+    if (m_RamEnabled && m_RamBankValue < m_RamBankCount) {
+      m_RamBank = m_Ram + m_RamBankValue * CartRam::BankSize;
+    } else {
+      m_RamBank = nullptr;
     }
-
-    ramFile.close();
   }
 } // hijo
\ No newline at end of file
@@ -4,7 +4,7 @@
 
 namespace hijo {
 
-  class MBC3 : public Mapper {
+  class MBC3 final : public Mapper {
   public:
     enum class RTCField {
       Seconds = 0x8,
@@ -34,20 +34,21 @@ namespace hijo {
 
     std::vector<StatLine> GetStats() override;
 
+    uint16_t RomBank() const override;
+
     void Tick(double timestep) override;
 
+  protected:
+    void MapPages() override;
+
   private:
     void SetRomBank(uint8_t value);
 
     void SetRamBank(uint8_t value);
 
-    void SaveRam();
-
-    void LoadRam();
+    void UpdateRamBank();
 
   private:
-    std::vector<std::vector<uint8_t>> m_RamBanks;
-
     RTC m_RTC;
     RTC m_ShadowRTC;
 
@@ -64,7 +65,11 @@ namespace hijo {
 
     uint32_t m_RomBankBase = 0;
 
-    bool m_NeedsSave = false;
+    // Follow the bank registers so reads skip the bank arithmetic,
+    // m_RamBank is null while RAM is disabled
+    const uint8_t *m_RomBank = nullptr;
+    uint8_t *m_RamBank = nullptr;
+
     bool m_PrevWriteZero = false;
 
     bool m_RTCBanked = false;
@@ -76,4 +81,35 @@ namespace hijo {
     bool m_TimerHalted = false;
   };
 
+  inline uint8_t MBC3::Read(uint16_t addr) {
+    if (addr < 0x4000) {
+      return m_Data[addr];
+    }
+
+    if (addr < 0x8000) {
+      return m_RomBank[addr - 0x4000];
+    }
+
+    if (!m_RamEnabled) {
+      return 0xFF;
+    }
+
+    if (m_RTCBanked) {
+      switch (m_SelectedField) {
+        case RTCField::Seconds:
+          return m_RTC.seconds;
+        case RTCField::Minutes:
+          return m_RTC.minutes;
+        case RTCField::Hours:
+          return m_RTC.hours;
+        case RTCField::DayLow:
+          return (m_RTC.day & 0xFF00) >> 8;
+        case RTCField::DayHigh:
+          return m_RTC.day & 0xFF;
+      }
+    }
+
+    return m_RamBank ? m_RamBank[addr - 0xA000] : 0xFF;
+  }
+
 } // hijo
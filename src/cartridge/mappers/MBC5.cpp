@@ -0,0 +1,129 @@
+#include "MBC5.h"
+
+#include <fmt/format.h>
+
+namespace hijo {
+
+  void MBC5::Write(uint16_t addr, uint8_t data) {
+    switch (addr & 0xF000) {
+      // Ram Enable, unlike MBC1 the whole byte has to match
+      case 0x0000:
+      case 0x1000:
+        m_RamEnabled = data == 0x0A;
+
+        if (!m_RamEnabled && m_Battery) {
+          m_Battery->Flush();
+        }
+
+        UpdateRamBank();
+        break;
+
+        // Rom Bank Number, low 8 bits
+      case 0x2000:
+        m_RomBankValue = (m_RomBankValue & 0x100) | data;
+        UpdateRomBank();
+        break;
+
+        // Rom Bank Number, bit 8
+      case 0x3000:
+        m_RomBankValue = (m_RomBankValue & 0xFF) | ((data & 1) << 8);
+        UpdateRomBank();
+        break;
+
+        // Ram Bank Number, rumble carts drive the motor with bit 3
+      case 0x4000:
+      case 0x5000:
+        if (m_HasRumble) {
+          m_Rumbling = (data & 0x8) != 0;
+          data &= 0x7;
+        }
+
+        m_RamBankValue = data & 0xF;
+        UpdateRamBank();
+        break;
+
+        // RAM Write
+      case 0xA000:
+      case 0xB000:
+        if (!m_RamBank) {
+          return;
+        }
+
+        m_RamBank[addr - 0xA000] = data;
+
+        if (m_Battery) {
+          m_Battery->MarkDirty((m_RamBank - m_Ram) + (addr - 0xA000));
+        }
+        return;
+    }
+
+    if (addr < 0x8000) {
+      UpdatePages();
+    }
+  }
+
+  void MBC5::SetRomBanks(uint16_t bankCount) {
+    m_RomBankCount = bankCount;
+    UpdateRomBank();
+  }
+
+  void MBC5::SetRamBanks(uint8_t bankCount) {
+    m_RamBankCount = bankCount;
+    OpenRam(m_RamBankCount * CartRam::BankSize);
+
+    UpdateRamBank();
+  }
+
+  void MBC5::UpdateRomBank() {
+    m_RomBankBase = 0x4000 * WrapRomBank(m_RomBankValue, m_RomBankCount);
+    m_RomBank = m_Data + m_RomBankBase;
+  }
+
+  void MBC5::UpdateRamBank() {
+    if (m_RamEnabled && m_RamBankCount > 0) {
+      m_RamBank = m_Ram + (m_RamBankValue % m_RamBankCount) * CartRam::BankSize;
+    } else {
+      m_RamBank = nullptr;
+    }
+  }
+
+  uint16_t MBC5::RomBank() const {
+    return m_RomBankBase / 0x4000;
+  }
+
+  void MBC5::MapPages() {
+    MapRomBank(0x0000, 0);
+    MapRomBank(0x4000, m_RomBankBase);
+
+    if (m_RamBank) {
+      // Battery backed RAM is written through Write, so the save sees it
+      m_Map->MapRead(0xA000, 0x2000, m_RamBank);
+      m_Map->MapWrite(0xA000, 0x2000, m_Battery ? nullptr : m_RamBank);
+    } else {
+      m_Map->Unmap(0xA000, 0x2000);
+    }
+  }
+
+  std::vector<Mapper::StatLine> MBC5::GetStats() {
+    std::vector<StatLine> lines;
+
+    lines.push_back({"Rom Bank Count", fmt::format("{}", m_RomBankCount)});
+    lines.push_back({"Ram Bank Count", fmt::format("{}", m_RamBankCount)});
+
+    lines.push_back({"Ram Enabled?", fmt::format("{}", m_RamEnabled ? "Yes" : "No")});
+
+    lines.push_back({"Selected Rom Bank", fmt::format("{}", m_RomBankValue)});
+    lines.push_back({"Selected Ram Bank", fmt::format("{}", m_RamBankValue)});
+
+    lines.push_back({"Rom Bank Base", fmt::format("0x{:06X}", m_RomBankBase)});
+
+    if (m_HasRumble) {
+      lines.push_back({"Rumbling?", m_Rumbling ? "Yes" : "No"});
+    }
+
+    lines.push_back({"Needs Save?", m_Battery && m_Battery->Dirty() ? "Yes" : "No"});
+
+    return lines;
+  }
+
+} // hijo
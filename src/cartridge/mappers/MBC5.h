@@ -0,0 +1,68 @@
+#pragma once
+
+#include <vector>
+
+#include "Mapper.h"
+
+namespace hijo {
+
+  class MBC5 final : public Mapper {
+  public:
+    MBC5(const std::string &path) : Mapper(path) {}
+
+    uint8_t Read(uint16_t addr) override;
+
+    void Write(uint16_t addr, uint8_t data) override;
+
+    void SetRomBanks(uint16_t bankCount) override;
+
+    void SetRamBanks(uint8_t bankCount) override;
+
+    std::vector<StatLine> GetStats() override;
+
+    uint16_t RomBank() const override;
+
+    // Motor state on rumble carts, bit 3 of the RAM bank register
+    bool Rumbling() const {
+      return m_Rumbling;
+    }
+
+  protected:
+    void MapPages() override;
+
+  private:
+    void UpdateRomBank();
+
+    void UpdateRamBank();
+
+  private:
+    uint16_t m_RomBankCount = 0;
+    uint8_t m_RamBankCount = 0;
+
+    bool m_RamEnabled = false;
+    bool m_Rumbling = false;
+
+    // 9 bits, bank 0 can be mapped at 0x4000 too
+    uint16_t m_RomBankValue = 1;
+    uint8_t m_RamBankValue = 0;
+
+    // Only change on bank select and RAM enable writes, so reads don't
+    // redo the bank arithmetic. m_RamBank is null while RAM is disabled.
+    uint32_t m_RomBankBase = 0x4000;
+    const uint8_t *m_RomBank = nullptr;
+    uint8_t *m_RamBank = nullptr;
+  };
+
+  inline uint8_t MBC5::Read(uint16_t addr) {
+    if (addr < 0x4000) {
+      return m_Data[addr];
+    }
+
+    if (addr < 0x8000) {
+      return m_RomBank[addr - 0x4000];
+    }
+
+    return m_RamBank ? m_RamBank[addr - 0xA000] : 0xFF;
+  }
+
+} // hijo
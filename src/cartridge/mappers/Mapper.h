@@ -1,12 +1,20 @@
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
+#include <memory>
+#include <span>
 #include <vector>
 #include <string>
 
 #include <iostream>
 #include <fstream>
 
+#include "system/MemoryMap.h"
+#include "cartridge/RomImage.h"
+#include "cartridge/BatteryRam.h"
+#include "cartridge/CartRam.h"
+
 namespace hijo {
 
   class Mapper {
@@ -38,22 +46,49 @@ namespace hijo {
 
     virtual ~Mapper() = default;
 
+    // Mappers define Read inline in their header, so Cartridge::Read<TMapper>
+    // can fold the bank lookup into the bus
     virtual uint8_t Read(uint16_t addr) = 0;
 
     virtual void Write(uint16_t addr, uint8_t data) = 0;
 
-    virtual void SetRomData(std::vector<uint8_t> &data) {
-      m_Data = data;
+    // Borrows the cartridge's ROM image, m_Data points into it
+    void SetRomData(std::shared_ptr<const RomImage> rom) {
+      m_Rom = std::move(rom);
+      m_Data = m_Rom->Data();
     }
 
     virtual void SetRomBanks(uint16_t) {};
 
     virtual void SetRamBanks(uint8_t) {}
 
+    // Bank currently mapped at 0x4000-0x7FFF
+    virtual uint16_t RomBank() const { return 1; }
+
+    // Every RAM bank in one block, for save states and debug views. Writes
+    // through here bypass the save's dirty tracking.
+    std::span<uint8_t> Ram() const {
+      return {m_Ram, m_RamSize};
+    }
+
     virtual std::vector<StatLine> GetStats() = 0;
 
     virtual void Tick(double) {}
 
+    // Counts down to the next periodic flush of the save
+    void TickBattery(double timestep) {
+      if (m_Battery) {
+        m_Battery->Tick(timestep);
+      }
+    }
+
+    // Hands the mapper the bus page table, it keeps its pages up to date from
+    // then on
+    void Attach(MemoryMap *map) {
+      m_Map = map;
+      MapPages();
+    }
+
     void SetFeatures(bool ram, bool battery, bool timer, bool rumble) {
       m_HasRam = ram;
       m_HasBattery = battery;
@@ -62,7 +97,66 @@ namespace hijo {
     }
 
   protected:
-    std::vector<uint8_t> m_Data;
+    // Allocates the cartridge RAM. With a battery the RAM is the image of
+    // <rom>.sav held by m_Battery, and the mapper reports every RAM write to
+    // it with MarkDirty.
+    void OpenRam(size_t size) {
+      if (size == 0) {
+        return;
+      }
+
+      if (m_HasBattery) {
+        m_Battery = std::make_unique<BatteryRam>(path + ".sav", size);
+        m_Ram = m_Battery->Data();
+      } else {
+        m_RamBuffer = CartRam(size);
+        m_Ram = m_RamBuffer.Data();
+      }
+
+      m_RamSize = size;
+    }
+
+    void UpdatePages() {
+      if (m_Map) {
+        MapPages();
+      }
+    }
+
+    // Points the cartridge pages at the current banks, pages a bank can't
+    // serve directly are left to Read/Write
+    virtual void MapPages() {}
+
+    // Banks past the end of the ROM wrap around, the upper bank lines
+    // aren't connected
+    uint16_t WrapRomBank(uint32_t bank, uint16_t bankCount) const {
+      auto available = static_cast<uint32_t>(m_Rom->Size() / 0x4000);
+      uint32_t count = bankCount ? std::min<uint32_t>(bankCount, available) : available;
+
+      return static_cast<uint16_t>(count ? bank % count : 1);
+    }
+
+    // Maps a 16k ROM bank, or leaves it to Read when it lies past the ROM image
+    void MapRomBank(uint16_t start, uint32_t base) {
+      if (base + 0x4000 <= m_Rom->Size()) {
+        m_Map->MapRead(start, 0x4000, m_Data + base);
+      } else {
+        m_Map->Unmap(start, 0x4000);
+      }
+
+      m_Map->MapWrite(start, 0x4000, nullptr);
+    }
+
+  protected:
+    std::shared_ptr<const RomImage> m_Rom;
+    const uint8_t *m_Data = nullptr;
+    MemoryMap *m_Map = nullptr;
+
+    std::unique_ptr<BatteryRam> m_Battery;
+
+    // Banks back to back, in m_RamBuffer or in m_Battery's image
+    CartRam m_RamBuffer;
+    uint8_t *m_Ram = nullptr;
+    size_t m_RamSize = 0;
 
     bool m_HasRam = false;
     bool m_HasBattery = false;
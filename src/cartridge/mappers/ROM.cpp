@@ -1,10 +1,6 @@
 #include "ROM.h"
 
 namespace hijo {
-  uint8_t ROM::Read(uint16_t addr) {
-    return m_Data[addr];
-  }
-
   void ROM::Write(uint16_t, uint8_t) {
     // Nothing to do with no Mapper.
   }
@@ -13,4 +9,9 @@ namespace hijo {
     return std::vector<Mapper::StatLine>();
   }
 
+  void ROM::MapPages() {
+    MapRomBank(0x0000, 0);
+    MapRomBank(0x4000, 0x4000);
+  }
+
 } // hijo
\ No newline at end of file
@@ -7,7 +7,7 @@
 
 namespace hijo {
 
-  class ROM : public Mapper {
+  class ROM final : public Mapper {
   public:
     ROM(const std::string &path) : Mapper(path) {}
 
@@ -16,7 +16,14 @@ namespace hijo {
     void Write(uint16_t addr, uint8_t data) override;
 
     std::vector<StatLine> GetStats() override;
+
+  protected:
+    void MapPages() override;
   };
 
+  inline uint8_t ROM::Read(uint16_t addr) {
+    return m_Data[addr];
+  }
+
 } // hijo
 
@@ -10,7 +10,6 @@
 #include "layers/UI.h"
 
 #include "system/Gameboy.h"
-#include "display/LCD.h"
 
 #include <SDL.h>
 
@@ -19,6 +18,8 @@ namespace hijo {
     if (!m_GameLayers)
       return;
 
+    System(&Gameboy::Get());
+
     m_GameLayers->PushState(CreateRef<Emu>());
     m_GameLayers->PushOverlay(CreateRef<UI>());
 
@@ -41,110 +42,6 @@ namespace hijo {
         layer->Update(m_Timestep);
       }
 
-      auto displayTile = [](uint16_t startLocation, uint16_t tileNum, int x, int y, int scale = 4,
-                            bool useBGPalette = false) {
-        auto &gb = Gameboy::Get();
-        auto &lcd = LCD::Get();
-
-        std::vector<Color> tileColors{
-            WHITE,
-            {0xAA, 0xAA, 0xAA, 0xFF},
-            {0x55, 0x55, 0x55, 0xFF},
-            BLACK
-        };
-
-        if (useBGPalette) {
-          tileColors = lcd.Regs().bgColors;
-        }
-
-        for (int tileY = 0; tileY < 16; tileY += 2) {
-          uint8_t b1 = gb.cpuRead(startLocation + (tileNum * 16) + tileY);
-          uint8_t b2 = gb.cpuRead(startLocation + (tileNum * 16) + tileY + 1);
-
-          for (int bit = 7; bit >= 0; bit--) {
-            uint8_t high = (!!(b1 & (1 << bit))) << 1;
-            uint8_t low = !!(b2 & (1 << bit));
-            uint8_t color = low | high;
-
-            auto rx = x + ((7 - bit) * scale);
-            auto ry = y + (tileY / 2 * scale);
-            auto w = scale;
-            auto h = scale;
-
-
-            DrawRectangle(rx, ry, w, h, tileColors[color]);
-          }
-        }
-      };
-
-      BeginTextureMode(m_TileTexture);
-      ClearBackground(m_DefaultBackground);
-      {
-        uint16_t addr = 0x8000;
-        int xDraw = 0;
-        int yDraw = 0;
-        int tileNum = 0;
-
-        for (int y = 0; y < 24; y++) {
-          for (int x = 0; x < 16; x++) {
-            displayTile(addr, tileNum, xDraw + (x * 4), yDraw + (y * 4));
-            xDraw += (8 * 4);
-            tileNum++;
-          }
-
-          yDraw += (8 * 4);
-          xDraw = 0;
-        }
-      }
-      EndTextureMode();
-
-      BeginTextureMode(m_PackedTileTexture);
-      ClearBackground(m_DefaultBackground);
-      {
-        uint16_t addr = 0x8000;
-        int xDraw = 0;
-        int yDraw = 0;
-        int tileNum = 0;
-
-        for (int y = 0; y < 24; y++) {
-          for (int x = 0; x < 16; x++) {
-            displayTile(addr, tileNum, xDraw, yDraw);
-            xDraw += (8 * 4);
-            tileNum++;
-          }
-
-          yDraw += (8 * 4);
-          xDraw = 0;
-        }
-      }
-      EndTextureMode();
-
-      BeginTextureMode(m_Tilemap1);
-      ClearBackground(m_DefaultBackground);
-      /* {
-         auto &gb = Gameboy::Get();
-         auto &lcd = LCD::Get();
-         //float scrollX = lcd.Regs().SCRX;
-         // float scrollY = lcd.Regs().SCRY;
-         uint16_t mapAddr = 0x9800;
-         uint16_t addr = lcd.LCDC_BGWTileDataArea();
-         bool altAddressing = addr == 0x8800;
-         int xDraw = 0;
-         int yDraw = 0;
-
-         for (int y = 0; y < 32; y++) {
-           for (int x = 0; x < 32; x++) {
-             uint8_t tileNum = gb.cpuRead(mapAddr++) + (altAddressing * 128);
-             displayTile(addr, tileNum, xDraw, yDraw, 2, false);
-             xDraw += (8 * 2);
-           }
-
-           yDraw += (8 * 2);
-           xDraw = 0;
-         }
-       }*/
-      EndTextureMode();
-
       BeginDrawing();
 
       for (const auto &layer: *m_GameLayers) {
@@ -198,18 +95,6 @@ namespace hijo {
     m_RenderTexture = LoadRenderTexture(m_ScreenWidth, m_ScreenHeight);
     SetTextureFilter(m_RenderTexture.texture, TEXTURE_FILTER_POINT);
 
-    m_TileTexture = LoadRenderTexture(36 * 16, 36 * 24);
-    SetTextureFilter(m_TileTexture.texture, TEXTURE_FILTER_POINT);
-
-    m_PackedTileTexture = LoadRenderTexture(32 * 16, 32 * 24);
-    SetTextureFilter(m_PackedTileTexture.texture, TEXTURE_FILTER_POINT);
-
-    m_Tilemap1 = LoadRenderTexture(32 * 16, 32 * 16);
-    SetTextureFilter(m_Tilemap1.texture, TEXTURE_FILTER_POINT);
-
-    // m_Tilemap2 = LoadRenderTexture(32 * 16, 32 * 16);
-    // SetTextureFilter(m_Tilemap2.texture, TEXTURE_FILTER_POINT);
-
     SDL_Init(SDL_INIT_AUDIO);
 
     EventManager::Get().Attach<
@@ -239,10 +124,6 @@ namespace hijo {
     delete m_GameLayers;
 
     UnloadRenderTexture(m_RenderTexture);
-    UnloadRenderTexture(m_TileTexture);
-    UnloadRenderTexture(m_PackedTileTexture);
-    UnloadRenderTexture(m_Tilemap1);
-    // UnloadRenderTexture(m_Tilemap2);
 
     SDL_Quit();
     CloseWindow();
@@ -7,6 +7,7 @@
 
 #include "common/common.h"
 #include "core/layers/GameLayerStack.h"
+#include "core/events/Events.h"
 #include "core/events/EventManager.h"
 
 #include "system/System.h"
@@ -31,12 +32,6 @@ namespace hijo {
 
     RenderTexture &GetRenderTexture() { return m_RenderTexture; }
 
-    RenderTexture &GetTileTexture() { return m_TileTexture; }
-
-    RenderTexture &GetPackedTileTexture() { return m_PackedTileTexture; }
-
-    RenderTexture &GetTilemap1Texture() { return m_Tilemap1; }
-
     int32_t ScreenWidth() {
       return m_ScreenWidth;
     }
@@ -104,9 +99,6 @@ namespace hijo {
 
     Camera2D m_Camera{};
     RenderTexture m_RenderTexture;
-    RenderTexture m_TileTexture;
-    RenderTexture m_PackedTileTexture;
-    RenderTexture m_Tilemap1;
 
     class System *m_System = nullptr;
   };
@@ -3,7 +3,7 @@
 #include <entt/entt.hpp>
 
 #include "Event.h"
-#include "Events.h"
+#include "SystemEvents.h"
 
 namespace hijo {
   class EventManager {
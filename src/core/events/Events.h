@@ -6,6 +6,7 @@
 #include "raylib.h"
 
 #include "Event.h"
+#include "SystemEvents.h"
 #include "core/input/InputActions.h"
 #include "core/input/Keys.h"
 
@@ -110,41 +111,13 @@ namespace hijo::Events {
     Vector2 position;
   };
 
-  struct ExecuteCPU : public Event {
-    ExecuteCPU(bool execute = true) : Event(), execute(execute) {}
-
-    bool execute;
-  };
-
-  struct StepCPU : public Event {
-    StepCPU() : Event() {}
-  };
-
-  struct ExecuteUntil : public Event {
-    ExecuteUntil(uint16_t addr) : Event(), addr(addr) {}
-
-    uint16_t addr;
-  };
-
-  struct VBlank : public Event {
-    VBlank() : Event() {}
-  };
-
   struct HandleAudio : public Event {
     HandleAudio() : Event() {}
   };
 
-  struct LoadROM : public Event {
-    LoadROM(const std::string &path) : Event(), path(path) {}
-
-    std::string path;
-  };
-
-  struct UnloadROM : public Event {
-    UnloadROM() : Event() {}
-  };
+  struct ScreenShader : public Event {
+    ScreenShader(bool enabled = false) : Event(), enabled(enabled) {}
 
-  struct Reset : public Event {
-    Reset() : Event() {}
+    bool enabled;
   };
-}
\ No newline at end of file
+}
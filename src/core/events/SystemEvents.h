@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "Event.h"
+
+// Events the emulation core sends and handles, free of any front-end types
+namespace hijo::Events {
+  struct ExecuteCPU : public Event {
+    ExecuteCPU(bool execute = true) : Event(), execute(execute) {}
+
+    bool execute;
+  };
+
+  struct StepCPU : public Event {
+    StepCPU() : Event() {}
+  };
+
+  struct ExecuteUntil : public Event {
+    ExecuteUntil(uint16_t addr) : Event(), addr(addr) {}
+
+    uint16_t addr;
+  };
+
+  struct VBlank : public Event {
+    VBlank() : Event() {}
+  };
+
+  struct LoadROM : public Event {
+    LoadROM(const std::string &path) : Event(), path(path) {}
+
+    std::string path;
+  };
+
+  struct UnloadROM : public Event {
+    UnloadROM() : Event() {}
+  };
+
+  struct Reset : public Event {
+    Reset() : Event() {}
+  };
+
+  // Samples the APU produced during the last frame, interleaved stereo at 48 kHz
+  struct AudioSamples : public Event {
+    AudioSamples(const int16_t *samples = nullptr, uint32_t count = 0)
+        : Event(), samples(samples), count(count) {}
+
+    const int16_t *samples;
+    uint32_t count;
+  };
+}
@@ -0,0 +1,170 @@
+#include "BlockCache.h"
+
+#include "Instructions.h"
+#include "common/common.h"
+#include "system/Gameboy.h"
+
+namespace hijo {
+
+  BlockCache::BlockCache() {
+    Clear();
+  }
+
+  const BlockCache::Block *BlockCache::Lookup(uint16_t pc) {
+    if (RegionEnd(pc) == 0) {
+      return nullptr;
+    }
+
+    Block *block = nullptr;
+
+    if (IsRam(pc)) {
+      auto [it, inserted] = m_RamBlocks.try_emplace(pc);
+      block = &it->second;
+
+      if (inserted) {
+        Decode(pc, *block);
+        TrackRamBlock(*block, 1);
+      } else {
+        m_Stats.hits++;
+      }
+    } else {
+      uint16_t bank = pc < 0x4000 ? 0 : m_RomBank;
+      auto [it, inserted] = m_RomBlocks.try_emplace((bank << 16) | pc);
+      block = &it->second;
+
+      if (inserted) {
+        block->bank = bank;
+        Decode(pc, *block);
+      } else {
+        m_Stats.hits++;
+      }
+    }
+
+    m_Stats.blocks = m_RomBlocks.size() + m_RamBlocks.size();
+
+    return block->entries.empty() ? nullptr : block;
+  }
+
+  void BlockCache::MapRomBank(uint16_t bank) {
+    if (bank == m_RomBank) {
+      return;
+    }
+
+    // Blocks stay keyed by their own bank, but anything currently running
+    // out of the 0x4000-0x7FFF window is no longer what the CPU will fetch.
+    m_RomBank = bank;
+    m_Generation++;
+    m_Stats.invalidations++;
+  }
+
+  void BlockCache::Clear() {
+    m_RomBlocks.clear();
+    m_RamBlocks.clear();
+    m_RamCode.fill(0);
+    m_RomBank = 1;
+    m_Generation++;
+    m_Stats = {};
+  }
+
+  uint32_t BlockCache::RegionEnd(uint16_t pc) {
+    if (pc < 0x4000) {
+      return 0x4000;
+    }
+
+    if (pc < 0x8000) {
+      return 0x8000;
+    }
+
+    if (IsBetween(pc, 0xC000, 0xDFFF)) {
+      return 0xE000;
+    }
+
+    if (IsBetween(pc, 0xFF80, 0xFFFE)) {
+      return 0xFFFF;
+    }
+
+    return 0;
+  }
+
+  void BlockCache::Decode(uint16_t pc, Block &block) {
+    auto &bus = Gameboy::Get();
+
+    uint32_t end = RegionEnd(pc);
+    uint32_t addr = pc;
+
+    m_Stats.misses++;
+
+    block.start = pc;
+    block.entries.clear();
+
+    while (block.entries.size() < MaxBlockLength) {
+      uint8_t opcode = bus.cpuRead(addr);
+      const auto &op = Instructions::OpcodeByByte(opcode);
+
+      if (addr + op.length > end) {
+        break;
+      }
+
+      Entry entry{static_cast<uint16_t>(addr), opcode, op.length, 0};
+
+      if (op.length > 1) {
+        entry.operand = bus.cpuRead(addr + 1);
+      }
+
+      if (op.length > 2) {
+        entry.operand |= bus.cpuRead(addr + 2) << 8;
+      }
+
+      block.entries.push_back(entry);
+      addr += op.length;
+
+      bool endsBlock = false;
+
+      switch (op.type) {
+        case Instruction::JP:
+        case Instruction::JR:
+        case Instruction::CALL:
+        case Instruction::RET:
+        case Instruction::RETI:
+        case Instruction::RST:
+        case Instruction::HALT:
+        case Instruction::STOP:
+          endsBlock = true;
+          break;
+
+        default:
+          break;
+      }
+
+      if (endsBlock) {
+        break;
+      }
+    }
+
+    block.end = static_cast<uint16_t>(addr);
+  }
+
+  void BlockCache::InvalidateRam(uint16_t addr) {
+    for (auto it = m_RamBlocks.begin(); it != m_RamBlocks.end();) {
+      auto &block = it->second;
+
+      if (addr >= block.start && addr < block.end) {
+        TrackRamBlock(block, -1);
+        it = m_RamBlocks.erase(it);
+        m_Stats.invalidations++;
+      } else {
+        ++it;
+      }
+    }
+
+    m_Stats.blocks = m_RomBlocks.size() + m_RamBlocks.size();
+    m_Generation++;
+  }
+
+  void BlockCache::TrackRamBlock(const Block &block, int8_t delta) {
+    for (uint32_t addr = block.start; addr < block.end; addr++) {
+      m_RamCode[RamIndex(addr)] += delta;
+    }
+  }
+
+} // hijo
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace hijo {
+
+  // Caches runs of predecoded instructions so the CPU can replay them without
+  // fetching and decoding every opcode again. ROM blocks are keyed by the bank
+  // mapped when they were decoded, WRAM/HRAM blocks are dropped when any byte
+  // they cover is written.
+  class BlockCache {
+  public:
+    struct Entry {
+      uint16_t pc;
+      uint8_t opcode;
+      uint8_t length;
+      uint16_t operand;
+    };
+
+    struct Block {
+      uint16_t bank = 0;
+      uint16_t start = 0;
+      uint16_t end = 0;
+      std::vector<Entry> entries;
+    };
+
+    struct Stats {
+      uint64_t hits = 0;
+      uint64_t misses = 0;
+      uint64_t invalidations = 0;
+      size_t blocks = 0;
+    };
+
+  public:
+    BlockCache();
+
+    // Returns the block starting at pc, decoding it on a miss. Returns nullptr
+    // if pc is outside ROM/WRAM/HRAM or no instruction fits in the region.
+    const Block *Lookup(uint16_t pc);
+
+    void MapRomBank(uint16_t bank);
+
+    void RamWrite(uint16_t addr) {
+      auto index = RamIndex(addr);
+
+      if (m_RamCode[index]) {
+        // Echo RAM writes land on the WRAM blocks they alias
+        InvalidateRam(addr >= 0xFF80 ? addr : 0xC000 | (addr & 0x1FFF));
+      }
+    }
+
+    void Clear();
+
+    uint32_t Generation() const {
+      return m_Generation;
+    }
+
+    // Only used to rewind to a recorded value when replaying bus traffic
+    void Generation(uint32_t generation) {
+      m_Generation = generation;
+    }
+
+    const Stats &GetStats() const {
+      return m_Stats;
+    }
+
+  private:
+    static constexpr size_t MaxBlockLength = 32;
+
+    // WRAM (C000-DFFF) followed by HRAM (FF80-FFFE)
+    static constexpr size_t RamCodeSize = 0x2000 + 0x80;
+
+    static size_t RamIndex(uint16_t addr) {
+      return addr >= 0xFF80 ? 0x2000 + (addr & 0x7F) : (addr & 0x1FFF);
+    }
+
+    static bool IsRam(uint16_t addr) {
+      return addr >= 0xC000;
+    }
+
+    static uint32_t RegionEnd(uint16_t pc);
+
+    void Decode(uint16_t pc, Block &block);
+
+    void InvalidateRam(uint16_t addr);
+
+    void TrackRamBlock(const Block &block, int8_t delta);
+
+  private:
+    std::unordered_map<uint32_t, Block> m_RomBlocks;
+    std::unordered_map<uint16_t, Block> m_RamBlocks;
+
+    // Number of cached RAM blocks covering each WRAM/HRAM byte
+    std::array<uint16_t, RamCodeSize> m_RamCode{};
+
+    uint16_t m_RomBank = 1;
+    uint32_t m_Generation = 0;
+
+    Stats m_Stats;
+  };
+
+} // hijo
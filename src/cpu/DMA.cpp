@@ -1,34 +1,52 @@
 #include "DMA.h"
 
+#include <algorithm>
+
 #include "system/Gameboy.h"
 
 namespace hijo {
   void DMA::Start(uint8_t start) {
+    auto &scheduler = Gameboy::Get().m_Scheduler;
+
     active = true;
     byte = 0;
-    startDelay = 2;
     value = start;
-  }
 
-  void DMA::Tick() {
-    if (!active) {
-      return;
-    }
+    // One byte at the end of every M-cycle once the start delay has passed
+    nextByte = scheduler.Now() + (StartDelay + 1) * 4;
 
-    if (startDelay) {
-      startDelay--;
-      return;
-    }
+    scheduler.Schedule(Scheduler::Event::DMA, nextByte + (Length - 1) * 4);
+  }
 
+  void DMA::CatchUp(uint64_t target) {
     auto &bus = Gameboy::Get();
     auto &ppu = bus.m_PPU;
 
-    uint16_t addr = (value * 0x100) + byte;
-
-    ppu.OAMWrite(0xFE00 | byte, bus.cpuRead(addr));
-
-    byte++;
-    active = byte < 0xA0;
+    while (active && nextByte <= target) {
+      // The PPU sees OAM as it was before this M-cycle's byte lands
+      ppu.CatchUp(nextByte);
+
+      uint16_t addr = (value * 0x100) + byte;
+      const uint8_t *page = bus.m_Map.ReadPage(addr);
+      uint8_t count = 1;
+
+      // Plain memory can't change or react to being read while we copy,
+      // so every byte due before the PPU next picks sprites lands at once.
+      // Anything else, and reads the bus is logging, go one at a time.
+      if (page && bus.m_BusMode == Gameboy::BusMode::Normal) {
+        uint64_t last = std::min(target, ppu.NextOAMScan());
+        uint64_t due = (last - nextByte) / 4 + 1;
+
+        count = static_cast<uint8_t>(std::min<uint64_t>(due, Length - byte));
+        ppu.OAMCopy(byte, page + byte, count);
+      } else {
+        ppu.OAMWrite(0xFE00 | byte, bus.cpuRead(addr));
+      }
+
+      byte += count;
+      active = byte < Length;
+      nextByte += count * 4;
+    }
   }
 
   bool DMA::Transferring() {
@@ -38,4 +56,4 @@ namespace hijo {
   void DMA::Reset() {
     active = false;
   }
-} // hijo
\ No newline at end of file
+} // hijo
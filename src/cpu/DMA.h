@@ -8,18 +8,24 @@ namespace hijo {
   public:
     void Start(uint8_t start);
 
-    void Tick();
+    // Copies every byte due up to the given bus timestamp
+    void CatchUp(uint64_t target);
 
     bool Transferring();
 
     void Reset();
 
+  private:
+    // M-cycles between the write to FF46 and the first copied byte
+    static constexpr uint8_t StartDelay = 2;
+
+    static constexpr uint8_t Length = 0xA0;
+
   private:
     bool active;
     uint8_t byte;
     uint8_t value;
-    uint8_t startDelay;
+    uint64_t nextByte;
   };
 
 } // hijo
-
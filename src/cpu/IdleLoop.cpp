@@ -0,0 +1,411 @@
+#include "IdleLoop.h"
+
+#include <algorithm>
+
+#include <spdlog/spdlog.h>
+
+#include "Instructions.h"
+#include "system/Gameboy.h"
+
+namespace hijo {
+
+  void IdleLoop::Check(SharpSM83 &cpu) {
+    auto &bus = Gameboy::Get();
+    uint16_t pc = cpu.regs.pc;
+    uint64_t now = bus.m_Scheduler.Now();
+
+    if (m_Expect.active) {
+      CheckExpectation(cpu, now);
+    }
+
+    uint16_t last = m_LastPc;
+    m_LastPc = pc;
+
+    if (m_Watch.active) {
+      if (pc < m_Watch.start || pc > m_Watch.loop->end) {
+        m_Watch.active = false;
+      } else if (pc == m_Watch.start) {
+        auto state = Capture(cpu);
+
+        // A full iteration without any event left the CPU where it started,
+        // so every iteration until a polled value changes is the same
+        if (bus.m_Scheduler.Processed() == m_Watch.events && state == m_Watch.state) {
+          Skip(cpu, *m_Watch.loop, now - m_Watch.time);
+        }
+
+        m_Watch.state = state;
+        m_Watch.time = bus.m_Scheduler.Now();
+        m_Watch.events = bus.m_Scheduler.Processed();
+        return;
+      } else {
+        return;
+      }
+    }
+
+    // Only a jump back to pc can have closed a loop there
+    if (pc > last || last - pc > MaxLoopBytes || pc >= 0x8000 || bus.m_TargetActive) {
+      return;
+    }
+
+    const auto &loop = Lookup(pc);
+
+    if (!loop.idle) {
+      return;
+    }
+
+    m_Watch.active = true;
+    m_Watch.start = pc;
+    m_Watch.loop = &loop;
+    m_Watch.state = Capture(cpu);
+    m_Watch.time = now;
+    m_Watch.events = bus.m_Scheduler.Processed();
+  }
+
+  void IdleLoop::Forget() {
+    m_Watch.active = false;
+    m_Expect.active = false;
+  }
+
+  void IdleLoop::Reset() {
+    m_Loops.clear();
+    m_LastPc = 0;
+    m_Stats = {};
+    Forget();
+  }
+
+  const IdleLoop::Loop &IdleLoop::Lookup(uint16_t pc) {
+    auto &bus = Gameboy::Get();
+    uint16_t bank = pc < 0x4000 ? 0 : bus.m_Cartridge->RomBank();
+
+    auto [it, inserted] = m_Loops.try_emplace((bank << 16) | pc);
+
+    if (inserted) {
+      it->second = Analyze(pc);
+
+      if (it->second.idle) {
+        m_Stats.loops++;
+      }
+    }
+
+    return it->second;
+  }
+
+  IdleLoop::Loop IdleLoop::Analyze(uint16_t start) {
+    auto &bus = Gameboy::Get();
+
+    Loop loop;
+    bool written[static_cast<size_t>(Register::PC) + 1]{};
+    bool boundary[MaxLoopBytes]{};
+    std::vector<uint16_t> targets;
+
+    auto write = [&written](Register reg) {
+      written[static_cast<size_t>(reg)] = true;
+    };
+
+    uint32_t pc = start;
+
+    while (pc < static_cast<uint32_t>(start) + MaxLoopBytes && pc < 0x8000) {
+      const auto &op = Instructions::OpcodeByByte(bus.cpuRead(pc));
+      uint16_t operand = 0;
+
+      if (op.length > 1) {
+        operand = bus.cpuRead(pc + 1);
+      }
+
+      if (op.length > 2) {
+        operand |= bus.cpuRead(pc + 2) << 8;
+      }
+
+      uint16_t next = pc + op.length;
+      boundary[pc - start] = true;
+
+      switch (op.type) {
+        case Instruction::NOP:
+        case Instruction::RLCA:
+        case Instruction::RRCA:
+        case Instruction::RLA:
+        case Instruction::RRA:
+        case Instruction::DAA:
+        case Instruction::CPL:
+        case Instruction::SCF:
+        case Instruction::CCF:
+          write(Register::A);
+          break;
+
+        case Instruction::JR:
+        case Instruction::JP: {
+          if (op.mode != AddressMode::D8 && op.mode != AddressMode::D16) {
+            return {};
+          }
+
+          uint16_t target = op.type == Instruction::JR
+                            ? static_cast<uint16_t>(next + static_cast<int8_t>(operand))
+                            : operand;
+
+          if (target == start) {
+            loop.end = pc;
+            loop.idle = true;
+          } else if (target <= pc) {
+            // Nested loops aren't tracked
+            return {};
+          } else {
+            targets.push_back(target);
+          }
+          break;
+        }
+
+        case Instruction::LD:
+        case Instruction::LDH:
+        case Instruction::INC:
+        case Instruction::DEC:
+        case Instruction::ADD:
+        case Instruction::ADC:
+        case Instruction::SUB:
+        case Instruction::SBC:
+        case Instruction::AND:
+        case Instruction::XOR:
+        case Instruction::OR:
+        case Instruction::CP:
+          switch (op.mode) {
+            case AddressMode::R:
+            case AddressMode::R_R:
+            case AddressMode::R_D8:
+            case AddressMode::R_D16:
+            case AddressMode::HL_SPR:
+              break;
+
+            case AddressMode::R_MR:
+              switch (op.reg2) {
+                case Register::BC:
+                  loop.reads.push_back({Source::BC, 0});
+                  break;
+                case Register::DE:
+                  loop.reads.push_back({Source::DE, 0});
+                  break;
+                case Register::HL:
+                  loop.reads.push_back({Source::HL, 0});
+                  break;
+                case Register::C:
+                  loop.reads.push_back({Source::C, 0});
+                  break;
+                default:
+                  return {};
+              }
+              break;
+
+            case AddressMode::R_A8:
+              loop.reads.push_back({Source::Absolute, static_cast<uint16_t>(0xFF00 | (operand & 0xFF))});
+              break;
+
+            case AddressMode::R_A16:
+              loop.reads.push_back({Source::Absolute, operand});
+              break;
+
+            default:
+              // Anything else writes memory
+              return {};
+          }
+
+          write(op.reg1);
+
+          if (op.mode == AddressMode::HL_SPR) {
+            write(Register::HL);
+          }
+          break;
+
+        case Instruction::CB: {
+          static constexpr Register registers[] = {
+              Register::B, Register::C, Register::D, Register::E,
+              Register::H, Register::L, Register::NONE, Register::A
+          };
+
+          auto reg = registers[operand & 0x7];
+          bool bit = (operand & 0xC0) == 0x40;
+
+          if (reg == Register::NONE) {
+            if (!bit) {
+              return {};
+            }
+
+            loop.reads.push_back({Source::HL, 0});
+          } else if (!bit) {
+            write(reg);
+          }
+          break;
+        }
+
+        default:
+          return {};
+      }
+
+      if (loop.idle) {
+        break;
+      }
+
+      pc = next;
+    }
+
+    if (!loop.idle) {
+      return {};
+    }
+
+    // Forward branches either leave the loop or land on an analysed instruction
+    for (auto target: targets) {
+      if (target <= loop.end && !boundary[target - start]) {
+        return {};
+      }
+    }
+
+    auto writes = [&written](std::initializer_list<Register> regs) {
+      return std::any_of(regs.begin(), regs.end(), [&written](Register reg) {
+        return written[static_cast<size_t>(reg)];
+      });
+    };
+
+    // Indirect reads have to hit the same address on every iteration
+    for (const auto &read: loop.reads) {
+      bool moves = false;
+
+      switch (read.source) {
+        case Source::BC:
+          moves = writes({Register::B, Register::C, Register::BC});
+          break;
+        case Source::DE:
+          moves = writes({Register::D, Register::E, Register::DE});
+          break;
+        case Source::HL:
+          moves = writes({Register::H, Register::L, Register::HL});
+          break;
+        case Source::C:
+          moves = writes({Register::C, Register::BC});
+          break;
+        default:
+          break;
+      }
+
+      if (moves) {
+        return {};
+      }
+    }
+
+    return loop;
+  }
+
+  uint16_t IdleLoop::Resolve(const Read &read, const SharpSM83 &cpu) {
+    const auto &regs = cpu.regs;
+
+    switch (read.source) {
+      case Source::BC:
+        return (regs.b << 8) | regs.c;
+      case Source::DE:
+        return (regs.d << 8) | regs.e;
+      case Source::HL:
+        return (regs.h << 8) | regs.l;
+      case Source::C:
+        return 0xFF00 | regs.c;
+      default:
+        return read.addr;
+    }
+  }
+
+  IdleLoop::Snapshot IdleLoop::Capture(const SharpSM83 &cpu) {
+    const auto &regs = cpu.regs;
+
+    return {regs.a, regs.f, regs.b, regs.c, regs.d, regs.e, regs.h, regs.l, regs.sp,
+            cpu.m_InterruptMasterEnabled, cpu.m_EnablingIME, cpu.m_IE, cpu.m_IF};
+  }
+
+  bool IdleLoop::Pollable(uint16_t addr) {
+    // ROM, VRAM, WRAM and its echo, HRAM and IE
+    if (addr < 0xA000 || (addr >= 0xC000 && addr < 0xFE00) || addr >= 0xFF80) {
+      return true;
+    }
+
+    switch (addr) {
+      case 0xFF04: // DIV
+      case 0xFF05: // TIMA
+      case 0xFF0F: // IF
+      case 0xFF41: // STAT
+      case 0xFF44: // LY
+        return true;
+
+      default:
+        return false;
+    }
+  }
+
+  void IdleLoop::Skip(SharpSM83 &cpu, const Loop &loop, uint64_t period) {
+    auto &bus = Gameboy::Get();
+    auto &scheduler = bus.m_Scheduler;
+    uint64_t now = scheduler.Now();
+
+    if (period == 0 || bus.m_TargetActive || bus.m_MCycleCount > Gameboy::MCyclesPerFrame ||
+        (m_Verify && m_Expect.active)) {
+      return;
+    }
+
+    // Events fire in the M-cycle that reaches them, and Update() has to see
+    // the end of the frame at the same instruction as before
+    uint64_t limit = std::min(scheduler.NextDeadline() - 1,
+                              now + (Gameboy::MCyclesPerFrame - bus.m_MCycleCount) * 4);
+
+    for (const auto &read: loop.reads) {
+      uint16_t addr = Resolve(read, cpu);
+
+      if (!Pollable(addr)) {
+        return;
+      }
+
+      if (addr == 0xFF04 || addr == 0xFF05) {
+        limit = std::min(limit, bus.m_Timer.NextChange(addr));
+      }
+    }
+
+    if (limit <= now) {
+      return;
+    }
+
+    uint64_t iterations = (limit - now) / period;
+
+    if (iterations == 0) {
+      return;
+    }
+
+    uint64_t cycles = iterations * period / 4;
+
+    if (m_Verify) {
+      m_Expect.active = true;
+      m_Expect.start = cpu.regs.pc;
+      m_Expect.end = loop.end;
+      m_Expect.time = now + iterations * period;
+      m_Expect.state = Capture(cpu);
+      return;
+    }
+
+    m_Stats.skips++;
+    m_Stats.skippedCycles += cycles;
+
+    bus.Cycles(static_cast<uint32_t>(cycles));
+  }
+
+  void IdleLoop::CheckExpectation(SharpSM83 &cpu, uint64_t now) {
+    uint16_t pc = cpu.regs.pc;
+
+    if (now < m_Expect.time && pc >= m_Expect.start && pc <= m_Expect.end) {
+      return;
+    }
+
+    m_Expect.active = false;
+
+    if (now == m_Expect.time && pc == m_Expect.start && Capture(cpu) == m_Expect.state) {
+      m_Stats.verified++;
+      return;
+    }
+
+    m_Stats.mismatches++;
+
+    spdlog::get("console")->warn("IdleLoop: skipping the loop at {:04X} would have diverged at {:04X}",
+                                 m_Expect.start, pc);
+  }
+
+} // hijo
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace hijo {
+
+  class SharpSM83;
+
+  // Spots short ROM loops that only poll values nothing but a peripheral can
+  // change, e.g. `ld a, [rLY]; cp 144; jr nz`. Once one iteration has been
+  // seen to bring the CPU back to the loop head in the same state, the
+  // machine is advanced by as many whole iterations as fit before the next
+  // scheduler deadline, the next DIV/TIMA change or the end of the frame.
+  class IdleLoop {
+  public:
+    struct Stats {
+      uint64_t loops = 0;
+      uint64_t skips = 0;
+      uint64_t skippedCycles = 0;
+      uint64_t verified = 0;
+      uint64_t mismatches = 0;
+    };
+
+  public:
+    // Called before every instruction Gameboy::Update() runs
+    void Check(SharpSM83 &cpu);
+
+    // Drops the loop being watched, keeps analysed loops and stats
+    void Forget();
+
+    void Reset();
+
+    bool Verifying() const {
+      return m_Verify;
+    }
+
+    // Runs the interpreter instead of skipping and checks that it ends up
+    // where the skip would have put the machine
+    void Verify(bool enabled) {
+      m_Verify = enabled;
+      Forget();
+    }
+
+    const Stats &GetStats() const {
+      return m_Stats;
+    }
+
+  private:
+    enum class Source : uint8_t {
+      Absolute,
+      BC,
+      DE,
+      HL,
+      C
+    };
+
+    struct Read {
+      Source source;
+      uint16_t addr;
+    };
+
+    struct Loop {
+      bool idle = false;
+      uint16_t end = 0;
+      std::vector<Read> reads;
+    };
+
+    // Everything an iteration could change without touching memory
+    struct Snapshot {
+      uint8_t a, f, b, c, d, e, h, l;
+      uint16_t sp;
+      bool ime;
+      bool enablingIME;
+      uint8_t ie;
+      uint8_t intFlags;
+
+      bool operator==(const Snapshot &other) const = default;
+    };
+
+    static constexpr uint16_t MaxLoopBytes = 16;
+
+    const Loop &Lookup(uint16_t pc);
+
+    static Loop Analyze(uint16_t start);
+
+    static uint16_t Resolve(const Read &read, const SharpSM83 &cpu);
+
+    static Snapshot Capture(const SharpSM83 &cpu);
+
+    // Values at these addresses only change through scheduler events or, for
+    // DIV/TIMA, at a cycle the timer can compute
+    static bool Pollable(uint16_t addr);
+
+    void Skip(SharpSM83 &cpu, const Loop &loop, uint64_t period);
+
+    void CheckExpectation(SharpSM83 &cpu, uint64_t now);
+
+  private:
+    std::unordered_map<uint32_t, Loop> m_Loops;
+
+    bool m_Verify = false;
+    uint16_t m_LastPc = 0;
+
+    struct {
+      bool active = false;
+      uint16_t start = 0;
+      const Loop *loop = nullptr;
+      uint64_t time = 0;
+      uint64_t events = 0;
+      Snapshot state{};
+    } m_Watch;
+
+    struct {
+      bool active = false;
+      uint16_t start = 0;
+      uint16_t end = 0;
+      uint64_t time = 0;
+      Snapshot state{};
+    } m_Expect;
+
+    Stats m_Stats;
+  };
+
+} // hijo
@@ -0,0 +1,819 @@
+#include "Jit.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "SharpSM83.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define HIJO_JIT_X64 1
+#endif
+
+#ifdef HIJO_JIT_X64
+#ifdef _WIN32
+#include <windows.h>
+#else
+
+#include <sys/mman.h>
+
+#endif
+#endif
+
+namespace hijo {
+
+  namespace {
+    // x86 register numbers used in ModRM fields
+    constexpr uint8_t EAX = 0;
+    constexpr uint8_t ECX = 1;
+
+    // Game Boy flag bits in F
+    constexpr uint8_t FlagZ = 0x80;
+    constexpr uint8_t FlagN = 0x40;
+    constexpr uint8_t FlagH = 0x20;
+    constexpr uint8_t FlagC = 0x10;
+
+    constexpr uint8_t OffsetA = offsetof(SharpSM83::Registers, a);
+    constexpr uint8_t OffsetF = offsetof(SharpSM83::Registers, f);
+    constexpr uint8_t OffsetPC = offsetof(SharpSM83::Registers, pc);
+    constexpr uint8_t OffsetSP = offsetof(SharpSM83::Registers, sp);
+
+    constexpr uint8_t OffsetRegs = offsetof(Jit::Frame, regs);
+    constexpr uint8_t OffsetBudget = offsetof(Jit::Frame, budget);
+    constexpr uint8_t OffsetPending = offsetof(Jit::Frame, pending);
+    constexpr uint8_t OffsetInstructions = offsetof(Jit::Frame, instructions);
+
+    // Offset of an 8-bit register, or of the high byte of a pair
+    uint8_t Offset(Register reg) {
+      switch (reg) {
+        case Register::A:
+          return OffsetA;
+        case Register::B:
+        case Register::BC:
+          return offsetof(SharpSM83::Registers, b);
+        case Register::C:
+          return offsetof(SharpSM83::Registers, c);
+        case Register::D:
+        case Register::DE:
+          return offsetof(SharpSM83::Registers, d);
+        case Register::E:
+          return offsetof(SharpSM83::Registers, e);
+        case Register::H:
+        case Register::HL:
+          return offsetof(SharpSM83::Registers, h);
+        case Register::L:
+          return offsetof(SharpSM83::Registers, l);
+        case Register::SP:
+          return OffsetSP;
+        default:
+          return OffsetPC;
+      }
+    }
+
+    bool Is8Bit(Register reg) {
+      return reg == Register::A || (reg >= Register::B && reg <= Register::L);
+    }
+
+    class Emitter {
+    public:
+      explicit Emitter(std::vector<uint8_t> &out) : m_Out(out) {}
+
+      void Bytes(std::initializer_list<uint8_t> bytes) {
+        m_Out.insert(m_Out.end(), bytes);
+      }
+
+      void Imm16(uint16_t value) {
+        m_Out.push_back(value & 0xFF);
+        m_Out.push_back(value >> 8);
+      }
+
+      void Imm32(uint32_t value) {
+        for (auto i = 0; i < 4; i++) {
+          m_Out.push_back((value >> (i * 8)) & 0xFF);
+        }
+      }
+
+      void Imm64(uint64_t value) {
+        for (auto i = 0; i < 8; i++) {
+          m_Out.push_back((value >> (i * 8)) & 0xFF);
+        }
+      }
+
+      size_t Position() const {
+        return m_Out.size();
+      }
+
+      void Patch32(size_t at, uint32_t value) {
+        for (auto i = 0; i < 4; i++) {
+          m_Out[at + i] = (value >> (i * 8)) & 0xFF;
+        }
+      }
+
+      // Points a rel32 emitted at `at` to `target`
+      void Link(size_t at, size_t target) {
+        Patch32(at, static_cast<uint32_t>(target - (at + 4)));
+      }
+
+      // Jcc rel32 (or JMP when cc is 0), returns the offset to Link
+      size_t Jump(uint8_t cc) {
+        if (cc) {
+          Bytes({0x0F, cc});
+        } else {
+          Bytes({0xE9});
+        }
+
+        size_t at = Position();
+        Imm32(0);
+
+        return at;
+      }
+
+      // ModRM for [rbp + offset], rbp holds the guest registers
+      void Guest(uint8_t op, uint8_t offset) {
+        Bytes({static_cast<uint8_t>(0x40 | (op << 3) | 5), offset});
+      }
+
+      // movzx reg, byte [rbp + offset]
+      void Load8(uint8_t reg, uint8_t offset) {
+        Bytes({0x0F, 0xB6});
+        Guest(reg, offset);
+      }
+
+      // mov byte [rbp + offset], reg
+      void Store8(uint8_t offset, uint8_t reg) {
+        Bytes({0x88});
+        Guest(reg, offset);
+      }
+
+      // mov byte [rbp + offset], imm8
+      void StoreImm8(uint8_t offset, uint8_t value) {
+        Bytes({0xC6});
+        Guest(0, offset);
+        Bytes({value});
+      }
+
+      // movzx reg, word [rbp + offset]
+      void Load16(uint8_t reg, uint8_t offset) {
+        Bytes({0x0F, 0xB7});
+        Guest(reg, offset);
+      }
+
+      // mov word [rbp + offset], ax
+      void Store16(uint8_t offset) {
+        Bytes({0x66, 0x89});
+        Guest(EAX, offset);
+      }
+
+      // mov word [rbp + offset], imm16
+      void StoreImm16(uint8_t offset, uint16_t value) {
+        Bytes({0x66, 0xC7});
+        Guest(0, offset);
+        Imm16(value);
+      }
+
+      // Register pairs are stored high byte first, the reverse of x86
+      void LoadPair(uint8_t reg, Register pair) {
+        Load16(reg, Offset(pair));
+
+        if (pair != Register::SP) {
+          // xchg al, ah / xchg cl, ch
+          Bytes({0x86, static_cast<uint8_t>(reg == EAX ? 0xC4 : 0xE9)});
+        }
+      }
+
+      void StorePair(Register pair) {
+        if (pair != Register::SP) {
+          // xchg al, ah
+          Bytes({0x86, 0xC4});
+        }
+
+        Store16(Offset(pair));
+      }
+
+      // Loads the guest carry into CF: bt dword [rbp + f], 4
+      void CarryIn() {
+        Bytes({0x0F, 0xBA});
+        Guest(4, OffsetF);
+        Bytes({4});
+      }
+
+      // cl = Z|H[|C] of the 8-bit op that just ran on al, with edx holding
+      // both of its inputs xored together
+      void ArithmeticFlags(bool carry) {
+        // setz cl
+        Bytes({0x0F, 0x94, 0xC1});
+
+        if (carry) {
+          // setc ch
+          Bytes({0x0F, 0x92, 0xC5});
+        }
+
+        // xor edx, eax; and edx, 0x10; add edx, edx
+        Bytes({0x31, 0xC2, 0x83, 0xE2, 0x10, 0x01, 0xD2});
+
+        // shl cl, 7
+        Bytes({0xC0, 0xE1, 0x07});
+
+        if (carry) {
+          // shl ch, 4; or cl, ch
+          Bytes({0xC0, 0xE5, 0x04, 0x08, 0xE9});
+        }
+
+        // or cl, dl
+        Bytes({0x08, 0xD1});
+      }
+
+      // cl = Z from ZF
+      void ZeroFlag() {
+        // setz cl; shl cl, 7
+        Bytes({0x0F, 0x94, 0xC1, 0xC0, 0xE1, 0x07});
+      }
+
+      // cl = C from CF
+      void CarryFlag() {
+        // setc cl; shl cl, 4
+        Bytes({0x0F, 0x92, 0xC1, 0xC0, 0xE1, 0x04});
+      }
+
+      // F = (F & ~mask) | cl | set, cl only has bits inside mask
+      void MergeFlags(uint8_t mask, uint8_t set) {
+        if (set) {
+          // or cl, set
+          Bytes({0x80, 0xC9, set});
+        }
+
+        // mov dl, [rbp + f]; and dl, ~mask; or dl, cl; mov [rbp + f], dl
+        Bytes({0x8A});
+        Guest(2, OffsetF);
+        Bytes({0x80, 0xE2, static_cast<uint8_t>(~mask), 0x08, 0xCA, 0x88});
+        Guest(2, OffsetF);
+      }
+
+      // Group 1 op on a guest byte: /1 or, /4 and, /6 xor
+      void GuestImm8(uint8_t op, uint8_t offset, uint8_t value) {
+        Bytes({0x80});
+        Guest(op, offset);
+        Bytes({value});
+      }
+
+    private:
+      std::vector<uint8_t> &m_Out;
+    };
+
+    // Writes the native code for everything but the jumps
+    void EmitNative(Emitter &emit, const Instructions::Opcode &op, uint16_t operand) {
+      switch (op.type) {
+        case Instruction::LD:
+          if (op.mode == AddressMode::R_D8) {
+            emit.StoreImm8(Offset(op.reg1), operand & 0xFF);
+          } else if (op.mode == AddressMode::R_D16) {
+            emit.StoreImm16(Offset(op.reg1),
+                            op.reg1 == Register::SP ? operand : static_cast<uint16_t>((operand >> 8) | (operand << 8)));
+          } else if (op.reg1 == Register::SP) {
+            // LD SP, HL
+            emit.LoadPair(EAX, Register::HL);
+            emit.StorePair(Register::SP);
+          } else if (op.reg1 != op.reg2) {
+            emit.Load8(EAX, Offset(op.reg2));
+            emit.Store8(Offset(op.reg1), EAX);
+          }
+          break;
+
+        case Instruction::INC:
+        case Instruction::DEC: {
+          bool inc = op.type == Instruction::INC;
+
+          if (Is8Bit(op.reg1)) {
+            emit.Load8(EAX, Offset(op.reg1));
+
+            // mov edx, eax; xor edx, 1; inc al / dec al
+            emit.Bytes({0x89, 0xC2, 0x83, 0xF2, 0x01, 0xFE, static_cast<uint8_t>(inc ? 0xC0 : 0xC8)});
+            emit.ArithmeticFlags(false);
+            emit.Store8(Offset(op.reg1), EAX);
+            emit.MergeFlags(FlagZ | FlagN | FlagH, inc ? 0 : FlagN);
+          } else if (op.reg1 == Register::SP) {
+            // inc word [rbp + sp] / dec word [rbp + sp]
+            emit.Bytes({0x66, 0xFF});
+            emit.Guest(inc ? 0 : 1, OffsetSP);
+          } else {
+            emit.LoadPair(EAX, op.reg1);
+
+            // inc eax / dec eax
+            emit.Bytes({0xFF, static_cast<uint8_t>(inc ? 0xC0 : 0xC8)});
+            emit.StorePair(op.reg1);
+          }
+          break;
+        }
+
+        case Instruction::ADD:
+          if (op.reg1 == Register::HL) {
+            emit.LoadPair(EAX, Register::HL);
+            emit.LoadPair(ECX, op.reg2);
+
+            // The carry into each bit is a ^ b ^ sum, H comes from bit 12
+            // and C from bit 16
+            emit.Bytes({
+                0x89, 0xC2,             // mov edx, eax
+                0x31, 0xCA,             // xor edx, ecx
+                0x01, 0xC8,             // add eax, ecx
+                0x31, 0xC2,             // xor edx, eax
+                0x89, 0xD1,             // mov ecx, edx
+                0xC1, 0xE9, 0x07,       // shr ecx, 7
+                0x83, 0xE1, FlagH,      // and ecx, H
+                0xC1, 0xEA, 0x0C,       // shr edx, 12
+                0x83, 0xE2, FlagC,      // and edx, C
+                0x09, 0xD1              // or ecx, edx
+            });
+
+            emit.StorePair(Register::HL);
+            emit.MergeFlags(FlagN | FlagH | FlagC, 0);
+            break;
+          }
+
+          [[fallthrough]];
+
+        case Instruction::ADC:
+        case Instruction::SUB:
+        case Instruction::SBC:
+        case Instruction::AND:
+        case Instruction::XOR:
+        case Instruction::OR:
+        case Instruction::CP: {
+          emit.Load8(EAX, OffsetA);
+
+          if (op.mode == AddressMode::R_R) {
+            emit.Load8(ECX, Offset(op.reg2));
+          } else {
+            // mov ecx, imm32
+            emit.Bytes({0xB9});
+            emit.Imm32(operand & 0xFF);
+          }
+
+          // mov edx, eax; xor edx, ecx
+          emit.Bytes({0x89, 0xC2, 0x31, 0xCA});
+
+          if (op.type == Instruction::ADC || op.type == Instruction::SBC) {
+            emit.CarryIn();
+          }
+
+          // <op> al, cl, CP subtracts too and just drops the result
+          uint8_t alu = 0x28;
+
+          switch (op.type) {
+            case Instruction::ADD:
+              alu = 0x00;
+              break;
+            case Instruction::ADC:
+              alu = 0x10;
+              break;
+            case Instruction::SBC:
+              alu = 0x18;
+              break;
+            case Instruction::AND:
+              alu = 0x20;
+              break;
+            case Instruction::XOR:
+              alu = 0x30;
+              break;
+            case Instruction::OR:
+              alu = 0x08;
+              break;
+            default:
+              break;
+          }
+
+          emit.Bytes({alu, 0xC8});
+
+          bool logic = op.type == Instruction::AND || op.type == Instruction::XOR || op.type == Instruction::OR;
+          bool subtract = op.type == Instruction::SUB || op.type == Instruction::SBC || op.type == Instruction::CP;
+
+          if (logic) {
+            emit.ZeroFlag();
+          } else {
+            emit.ArithmeticFlags(true);
+          }
+
+          if (op.type != Instruction::CP) {
+            emit.Store8(OffsetA, EAX);
+          }
+
+          emit.MergeFlags(FlagZ | FlagN | FlagH | FlagC,
+                          op.type == Instruction::AND ? FlagH : subtract ? FlagN : 0);
+          break;
+        }
+
+        case Instruction::RLCA:
+        case Instruction::RRCA:
+        case Instruction::RLA:
+        case Instruction::RRA: {
+          emit.Load8(EAX, OffsetA);
+
+          if (op.type == Instruction::RLA || op.type == Instruction::RRA) {
+            emit.CarryIn();
+          }
+
+          // rol / ror / rcl / rcr al, 1
+          uint8_t rotate = op.type == Instruction::RLCA ? 0xC0 :
+                           op.type == Instruction::RRCA ? 0xC8 :
+                           op.type == Instruction::RLA ? 0xD0 : 0xD8;
+
+          emit.Bytes({0xD0, rotate});
+          emit.CarryFlag();
+          emit.Store8(OffsetA, EAX);
+          emit.MergeFlags(FlagZ | FlagN | FlagH | FlagC, 0);
+          break;
+        }
+
+        case Instruction::CPL:
+          // not byte [rbp + a]
+          emit.Bytes({0xF6});
+          emit.Guest(2, OffsetA);
+          emit.GuestImm8(1, OffsetF, FlagN | FlagH);
+          break;
+
+        case Instruction::SCF:
+          emit.GuestImm8(4, OffsetF, static_cast<uint8_t>(~(FlagN | FlagH)));
+          emit.GuestImm8(1, OffsetF, FlagC);
+          break;
+
+        case Instruction::CCF:
+          emit.GuestImm8(4, OffsetF, static_cast<uint8_t>(~(FlagN | FlagH)));
+          emit.GuestImm8(6, OffsetF, FlagC);
+          break;
+
+        default:
+          break;
+      }
+    }
+  }
+
+  Jit::Jit() {
+#ifdef HIJO_JIT_X64
+#ifdef _WIN32
+    m_Code = static_cast<uint8_t *>(VirtualAlloc(nullptr, CodeSize, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+#else
+    void *code = mmap(nullptr, CodeSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    m_Code = code == MAP_FAILED ? nullptr : static_cast<uint8_t *>(code);
+#endif
+#endif
+  }
+
+  Jit::~Jit() {
+#ifdef HIJO_JIT_X64
+    if (m_Code) {
+#ifdef _WIN32
+      VirtualFree(m_Code, 0, MEM_RELEASE);
+#else
+      munmap(m_Code, CodeSize);
+#endif
+    }
+#endif
+  }
+
+  bool Jit::Supported() {
+#ifdef HIJO_JIT_X64
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  Jit::CompiledBlock Jit::Lookup(const BlockCache::Block &block, const HandlerTable &handlers) {
+    if (block.start >= 0x8000) {
+      return nullptr;
+    }
+
+    uint32_t key = (block.bank << 16) | block.start;
+    auto &entry = m_Blocks[key];
+
+    if (entry.code) {
+      m_Stats.executions++;
+      return entry.code;
+    }
+
+    if (entry.rejected || ++entry.executions < HotThreshold) {
+      m_Stats.interpreted++;
+      return nullptr;
+    }
+
+    if (!m_Code || IsIOHeavy(block)) {
+      entry.rejected = true;
+      m_Stats.interpreted++;
+      return nullptr;
+    }
+
+    auto code = Compile(block, handlers);
+
+    if (!code) {
+      // Out of code space, start over with an empty cache
+      m_Stats.flushes++;
+      Clear();
+      code = Compile(block, handlers);
+    }
+
+    m_Blocks[key].code = code;
+    m_Stats.executions++;
+
+    return code;
+  }
+
+  void Jit::Clear() {
+    m_Blocks.clear();
+    m_CodeUsed = 0;
+    m_Stats.codeBytes = 0;
+  }
+
+  bool Jit::IsIOHeavy(const BlockCache::Block &block) {
+    size_t io = 0;
+
+    for (const auto &entry: block.entries) {
+      const auto &op = Instructions::OpcodeByByte(entry.opcode);
+
+      bool highPage = op.type == Instruction::LDH ||
+                      (op.mode == AddressMode::R_MR && op.reg2 == Register::C) ||
+                      (op.mode == AddressMode::MR_R && op.reg1 == Register::C);
+
+      bool absolute = (op.mode == AddressMode::A16_R || op.mode == AddressMode::R_A16) &&
+                      entry.operand >= 0xFF00 && entry.operand < 0xFF80;
+
+      if (highPage || absolute) {
+        io++;
+      }
+    }
+
+    return io * 2 >= block.entries.size();
+  }
+
+  bool Jit::IsNative(const Instructions::Opcode &op) {
+    switch (op.type) {
+      case Instruction::NOP:
+      case Instruction::RLCA:
+      case Instruction::RRCA:
+      case Instruction::RLA:
+      case Instruction::RRA:
+      case Instruction::CPL:
+      case Instruction::SCF:
+      case Instruction::CCF:
+      case Instruction::JR:
+        return true;
+
+      case Instruction::LD:
+        if (op.mode == AddressMode::R_R) {
+          return (Is8Bit(op.reg1) && Is8Bit(op.reg2)) ||
+                 (op.reg1 == Register::SP && op.reg2 == Register::HL);
+        }
+
+        return (op.mode == AddressMode::R_D8 && Is8Bit(op.reg1)) || op.mode == AddressMode::R_D16;
+
+      case Instruction::INC:
+      case Instruction::DEC:
+        return op.mode == AddressMode::R;
+
+      case Instruction::ADD:
+        return op.mode == AddressMode::R_R || (op.mode == AddressMode::R_D8 && op.reg1 == Register::A);
+
+      case Instruction::ADC:
+      case Instruction::SUB:
+      case Instruction::SBC:
+      case Instruction::AND:
+      case Instruction::XOR:
+      case Instruction::OR:
+      case Instruction::CP:
+        return op.mode == AddressMode::R_R || op.mode == AddressMode::R_D8;
+
+      case Instruction::JP:
+        return op.mode == AddressMode::D16 || op.mode == AddressMode::R;
+
+      default:
+        return false;
+    }
+  }
+
+  uint32_t Jit::NativeCycles(const Instructions::Opcode &op) {
+    // Opcode fetch, then one per operand byte
+    uint32_t cycles = 1;
+
+    if (op.mode == AddressMode::R_D8 || op.mode == AddressMode::D8) {
+      cycles += 1;
+    } else if (op.mode == AddressMode::R_D16 || op.mode == AddressMode::D16) {
+      cycles += 2;
+    }
+
+    bool wide = op.reg1 == Register::BC || op.reg1 == Register::DE ||
+                op.reg1 == Register::HL || op.reg1 == Register::SP;
+
+    // 16-bit INC, DEC and ADD take an internal cycle, a taken jump one more
+    if ((op.type == Instruction::INC || op.type == Instruction::DEC || op.type == Instruction::ADD) && wide) {
+      cycles++;
+    }
+
+    if (op.type == Instruction::JR || op.type == Instruction::JP) {
+      cycles++;
+    }
+
+    return cycles;
+  }
+
+  Jit::CompiledBlock Jit::Compile(const BlockCache::Block &block, const HandlerTable &handlers) {
+#ifdef HIJO_JIT_X64
+    // A native instruction that didn't fit in the budget
+    struct SlowPath {
+      size_t entry;
+      uint8_t cycles;
+      size_t branch;
+      size_t resume;
+    };
+
+    std::vector<uint8_t> out;
+    std::vector<SlowPath> slowPaths;
+    std::vector<size_t> exits;
+    Emitter emit(out);
+
+    // rbx = cpu, rbp = guest registers, r12d = pending M-cycles,
+    // r13d = native instructions run, r14 = frame, r15d = budget
+    emit.Bytes({0x53, 0x55, 0x41, 0x54, 0x41, 0x55, 0x41, 0x56, 0x41, 0x57});
+
+#ifdef _WIN32
+    // sub rsp, 40; mov rbx, rcx; mov r14, rdx
+    emit.Bytes({0x48, 0x83, 0xEC, 0x28, 0x48, 0x89, 0xCB, 0x49, 0x89, 0xD6});
+#else
+    // sub rsp, 8; mov rbx, rdi; mov r14, rsi
+    emit.Bytes({0x48, 0x83, 0xEC, 0x08, 0x48, 0x89, 0xFB, 0x49, 0x89, 0xF6});
+#endif
+
+    // mov rbp, [r14 + regs]; mov r15d, [r14 + budget]; xor r12d, r12d; xor r13d, r13d
+    emit.Bytes({0x49, 0x8B, 0x6E, OffsetRegs, 0x45, 0x8B, 0x7E, OffsetBudget,
+                0x45, 0x31, 0xE4, 0x45, 0x31, 0xED});
+
+    // Runs the entry through its handler, which takes the pending cycles and
+    // hands back a new budget
+    auto call = [&](const BlockCache::Entry &entry) {
+      emit.StoreImm16(OffsetPC, entry.pc);
+
+#ifdef _WIN32
+      // mov rcx, rbx; mov edx, operand; mov r8d, r12d
+      emit.Bytes({0x48, 0x89, 0xD9, 0xBA});
+      emit.Imm32(entry.operand);
+      emit.Bytes({0x45, 0x89, 0xE0});
+#else
+      // mov rdi, rbx; mov esi, operand; mov edx, r12d
+      emit.Bytes({0x48, 0x89, 0xDF, 0xBE});
+      emit.Imm32(entry.operand);
+      emit.Bytes({0x44, 0x89, 0xE2});
+#endif
+
+      // mov rax, handler; call rax; xor r12d, r12d
+      emit.Bytes({0x48, 0xB8});
+      emit.Imm64(reinterpret_cast<uint64_t>(handlers[entry.opcode]));
+      emit.Bytes({0xFF, 0xD0, 0x45, 0x31, 0xE4});
+
+      // test eax, eax; js exit; mov r15d, eax
+      emit.Bytes({0x85, 0xC0});
+      exits.push_back(emit.Jump(0x88));
+      emit.Bytes({0x41, 0x89, 0xC7});
+    };
+
+    size_t native = 0;
+
+    for (size_t i = 0; i < block.entries.size(); i++) {
+      const auto &entry = block.entries[i];
+      const auto &op = Instructions::OpcodeByByte(entry.opcode);
+
+      if (!IsNative(op)) {
+        call(entry);
+        continue;
+      }
+
+      auto cycles = static_cast<uint8_t>(NativeCycles(op));
+
+      // add r12d, cycles; cmp r12d, r15d; ja slow; inc r13d
+      emit.Bytes({0x41, 0x83, 0xC4, cycles, 0x45, 0x39, 0xFC});
+      slowPaths.push_back({i, cycles, emit.Jump(0x87), 0});
+      emit.Bytes({0x41, 0xFF, 0xC5});
+
+      if (op.type == Instruction::JR || op.type == Instruction::JP) {
+        size_t notTaken = 0;
+
+        if (op.cond != Condition::NONE) {
+          bool zero = op.cond == Condition::Z || op.cond == Condition::NZ;
+          bool set = op.cond == Condition::Z || op.cond == Condition::C;
+
+          // test byte [rbp + f], flag; jz/jnz not taken
+          emit.Bytes({0xF6});
+          emit.Guest(0, OffsetF);
+          emit.Bytes({zero ? FlagZ : FlagC});
+          notTaken = emit.Jump(set ? 0x84 : 0x85);
+        }
+
+        if (op.mode == AddressMode::R) {
+          emit.LoadPair(EAX, Register::HL);
+          emit.Store16(OffsetPC);
+        } else if (op.type == Instruction::JR) {
+          uint16_t next = entry.pc + entry.length;
+          emit.StoreImm16(OffsetPC, next + static_cast<int8_t>(entry.operand & 0xFF));
+        } else {
+          emit.StoreImm16(OffsetPC, entry.operand);
+        }
+
+        exits.push_back(emit.Jump(0));
+
+        if (op.cond != Condition::NONE) {
+          emit.Link(notTaken, emit.Position());
+
+          // sub r12d, 1, a jump that isn't taken doesn't reload PC
+          emit.Bytes({0x41, 0x83, 0xEC, 0x01});
+        }
+      } else {
+        EmitNative(emit, op, entry.operand);
+      }
+
+      slowPaths.back().resume = emit.Position();
+      native++;
+    }
+
+    // Ran off the end of the block
+    const auto &last = block.entries.back();
+    emit.StoreImm16(OffsetPC, last.pc + last.length);
+
+    size_t exit = emit.Position();
+
+    // mov [r14 + pending], r12d; mov [r14 + instructions], r13d
+    emit.Bytes({0x45, 0x89, 0x66, OffsetPending, 0x45, 0x89, 0x6E, OffsetInstructions});
+
+#ifdef _WIN32
+    // add rsp, 40
+    emit.Bytes({0x48, 0x83, 0xC4, 0x28});
+#else
+    // add rsp, 8
+    emit.Bytes({0x48, 0x83, 0xC4, 0x08});
+#endif
+
+    // pop r15; pop r14; pop r13; pop r12; pop rbp; pop rbx; ret
+    emit.Bytes({0x41, 0x5F, 0x41, 0x5E, 0x41, 0x5D, 0x41, 0x5C, 0x5D, 0x5B, 0xC3});
+
+    for (const auto &slow: slowPaths) {
+      emit.Link(slow.branch, emit.Position());
+
+      // sub r12d, cycles
+      emit.Bytes({0x41, 0x83, 0xEC, slow.cycles});
+      call(block.entries[slow.entry]);
+      emit.Link(emit.Jump(0), slow.resume);
+    }
+
+    for (auto at: exits) {
+      emit.Link(at, exit);
+    }
+
+    // Keep each block 16 byte aligned
+    size_t size = (out.size() + 15) & ~static_cast<size_t>(15);
+
+    if (m_CodeUsed + size > CodeSize) {
+      return nullptr;
+    }
+
+    if (!Writable(true)) {
+      return nullptr;
+    }
+
+    uint8_t *code = m_Code + m_CodeUsed;
+    std::copy(out.begin(), out.end(), code);
+    m_CodeUsed += size;
+
+    if (!Writable(false)) {
+      return nullptr;
+    }
+
+    m_Stats.compiled++;
+    m_Stats.instructions += block.entries.size();
+    m_Stats.nativeInstructions += native;
+    m_Stats.codeBytes = m_CodeUsed;
+
+    return reinterpret_cast<CompiledBlock>(code);
+#else
+    return nullptr;
+#endif
+  }
+
+  bool Jit::Writable(bool writable) {
+#ifdef HIJO_JIT_X64
+#ifdef _WIN32
+    DWORD old;
+    bool ok = VirtualProtect(m_Code, CodeSize, writable ? PAGE_READWRITE : PAGE_EXECUTE_READ, &old);
+#else
+    bool ok = mprotect(m_Code, CodeSize, writable ? (PROT_READ | PROT_WRITE) : (PROT_READ | PROT_EXEC)) == 0;
+#endif
+
+    if (!ok) {
+      spdlog::get("console")->warn("Jit: couldn't change code buffer protection");
+    }
+
+    return ok;
+#else
+    return false;
+#endif
+  }
+
+} // hijo
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+#include "BlockCache.h"
+#include "Instructions.h"
+
+namespace hijo {
+
+  class SharpSM83;
+
+  // x86-64 backend for hot ROM blocks. Register loads, 8-bit ALU ops, INC/DEC,
+  // ADD HL, the A rotates, the flag ops and JR/JP are translated to native
+  // code that works on SharpSM83::Registers directly and keeps a running
+  // count of the M-cycles it used. Anything that touches the bus calls the
+  // CPU's per-opcode handler, which hands those cycles to Gameboy::Cycles()
+  // first so every access still happens at its interpreter timestamp.
+  //
+  // Native instructions only run while nothing can come due: the CPU passes
+  // a budget of M-cycles before the next scheduler deadline or the end of the
+  // frame, and an instruction that doesn't fit goes through its handler.
+  class Jit {
+  public:
+    // What RunCompiled and the generated code share
+    struct Frame {
+      void *regs;
+      uint32_t budget;
+      uint32_t pending = 0;
+      uint32_t instructions = 0;
+    };
+
+    using CompiledBlock = void (*)(SharpSM83 *cpu, Frame *frame);
+
+    // Runs one instruction after passing the pending M-cycles to the bus.
+    // Returns the budget for the native code that follows, or Stop.
+    using InstructionHandler = int32_t (*)(SharpSM83 *cpu, uint32_t operand, uint32_t pending);
+    using HandlerTable = std::array<InstructionHandler, 256>;
+
+    static constexpr int32_t Stop = -1;
+
+    struct Stats {
+      uint64_t compiled = 0;
+      uint64_t interpreted = 0;
+      uint64_t executions = 0;
+      uint64_t flushes = 0;
+      uint64_t lockstepChecks = 0;
+      uint64_t divergences = 0;
+      uint64_t instructions = 0;
+      uint64_t nativeInstructions = 0;
+      size_t codeBytes = 0;
+    };
+
+  public:
+    Jit();
+
+    ~Jit();
+
+    Jit(const Jit &) = delete;
+
+    Jit &operator=(const Jit &) = delete;
+
+    static bool Supported();
+
+    // Returns native code for the block once it has run HotThreshold times,
+    // nullptr while it should still be interpreted. Only ROM blocks compile,
+    // RAM code can change under them.
+    CompiledBlock Lookup(const BlockCache::Block &block, const HandlerTable &handlers);
+
+    void Clear();
+
+    Stats &GetStats() {
+      return m_Stats;
+    }
+
+  private:
+    struct Entry {
+      uint32_t executions = 0;
+      CompiledBlock code = nullptr;
+      bool rejected = false;
+    };
+
+    static constexpr uint32_t HotThreshold = 16;
+    static constexpr size_t CodeSize = 4 * 1024 * 1024;
+
+    static bool IsIOHeavy(const BlockCache::Block &block);
+
+    // Instructions that only read and write registers and flags
+    static bool IsNative(const Instructions::Opcode &op);
+
+    // M-cycles the interpreter spends on a native instruction, counting a
+    // conditional jump as taken
+    static uint32_t NativeCycles(const Instructions::Opcode &op);
+
+    CompiledBlock Compile(const BlockCache::Block &block, const HandlerTable &handlers);
+
+    bool Writable(bool writable);
+
+  private:
+    // Keyed on (bank << 16) | start like the ROM blocks in BlockCache, so an
+    // entry stays tied to the ROM bytes it was compiled from whatever
+    // BlockCache does with its own blocks
+    std::unordered_map<uint32_t, Entry> m_Blocks;
+
+    uint8_t *m_Code = nullptr;
+    size_t m_CodeUsed = 0;
+
+    Stats m_Stats;
+  };
+
+} // hijo
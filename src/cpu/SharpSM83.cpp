@@ -20,6 +20,18 @@ namespace hijo {
     m_IF = 0;
     m_InterruptMasterEnabled = false;
     m_EnablingIME = false;
+
+    m_BlockCache.Clear();
+    m_Block = nullptr;
+    m_Jit.Clear();
+    m_HaltStats = {};
+    m_Instructions = 0;
+    m_IdleLoop.Reset();
+  }
+
+  void SharpSM83::UseBlockCache(bool enabled) {
+    m_UseBlockCache = enabled;
+    m_Block = nullptr;
   }
 
   uint16_t SharpSM83::Reg(const Register &t) {
@@ -176,235 +188,547 @@ namespace hijo {
     }
   }
 
-  SharpSM83::InstructionProc SharpSM83::GetProcessor(Instruction type) {
-    return m_Processors[type];
+  template<Register t>
+  uint16_t SharpSM83::Reg() {
+    if constexpr (t == Register::A) {
+      return regs.a;
+    } else if constexpr (t == Register::F) {
+      return regs.f;
+    } else if constexpr (t == Register::B) {
+      return regs.b;
+    } else if constexpr (t == Register::C) {
+      return regs.c;
+    } else if constexpr (t == Register::D) {
+      return regs.d;
+    } else if constexpr (t == Register::E) {
+      return regs.e;
+    } else if constexpr (t == Register::H) {
+      return regs.h;
+    } else if constexpr (t == Register::L) {
+      return regs.l;
+    } else if constexpr (t == Register::AF) {
+      return (regs.a << 8) | regs.f;
+    } else if constexpr (t == Register::BC) {
+      return (regs.b << 8) | regs.c;
+    } else if constexpr (t == Register::DE) {
+      return (regs.d << 8) | regs.e;
+    } else if constexpr (t == Register::HL) {
+      return (regs.h << 8) | regs.l;
+    } else if constexpr (t == Register::PC) {
+      return regs.pc;
+    } else if constexpr (t == Register::SP) {
+      return regs.sp;
+    } else {
+      return 0;
+    }
+  }
+
+  template<Register t>
+  void SharpSM83::Reg(uint16_t value) {
+    if constexpr (t == Register::A) {
+      regs.a = value & 0xFF;
+    } else if constexpr (t == Register::F) {
+      regs.f = value & 0xFF;
+    } else if constexpr (t == Register::B) {
+      regs.b = value & 0xFF;
+    } else if constexpr (t == Register::C) {
+      regs.c = value & 0xFF;
+    } else if constexpr (t == Register::D) {
+      regs.d = value & 0xFF;
+    } else if constexpr (t == Register::E) {
+      regs.e = value & 0xFF;
+    } else if constexpr (t == Register::H) {
+      regs.h = value & 0xFF;
+    } else if constexpr (t == Register::L) {
+      regs.l = value & 0xFF;
+    } else if constexpr (t == Register::AF) {
+      regs.a = value >> 8;
+      regs.f = value & 0xFF;
+    } else if constexpr (t == Register::BC) {
+      regs.b = value >> 8;
+      regs.c = value & 0xFF;
+    } else if constexpr (t == Register::DE) {
+      regs.d = value >> 8;
+      regs.e = value & 0xFF;
+    } else if constexpr (t == Register::HL) {
+      regs.h = value >> 8;
+      regs.l = value & 0xFF;
+    } else if constexpr (t == Register::PC) {
+      regs.pc = value;
+    } else if constexpr (t == Register::SP) {
+      regs.sp = value;
+    }
+  }
+
+  template<Register t>
+  uint8_t SharpSM83::Reg8() {
+    if constexpr (t == Register::HL) {
+      return Gameboy::Get().cpuRead(Reg<Register::HL>());
+    } else {
+      static_assert(!Is16Bit(t), "Reg8 requires an 8-bit register or (HL)");
+      return Reg<t>();
+    }
+  }
+
+  template<Register t>
+  void SharpSM83::Reg8(uint8_t value) {
+    if constexpr (t == Register::HL) {
+      Gameboy::Get().cpuWrite(Reg<Register::HL>(), value);
+    } else {
+      static_assert(!Is16Bit(t), "Reg8 requires an 8-bit register or (HL)");
+      Reg<t>(value);
+    }
+  }
+
+  template<bool predecoded>
+  uint8_t SharpSM83::FetchOperand(uint8_t offset) {
+    if constexpr (predecoded) {
+      return (m_Operand >> (offset * 8)) & 0xFF;
+    } else {
+      return Gameboy::Get().cpuFetch(regs.pc + offset);
+    }
   }
 
+  template<AddressMode mode, Register reg1, Register reg2, bool predecoded>
   void SharpSM83::FetchData() {
     auto &bus = Gameboy::Get();
 
     m_MemoryDestination = 0;
-    DestinationIsMemory = false;
 
-    if (m_CurrentInstruction == NULL) {
-      spdlog::get("console")->warn("FetchData:  Current Instruction is Null!");
+    if constexpr (mode == AddressMode::IMP) {
       return;
-    }
-
-    switch (m_CurrentInstruction->mode) {
-      case AddressMode::IMP:
-        return;
+    } else if constexpr (mode == AddressMode::R) {
+      m_FetchedData = Reg<reg1>();
+    } else if constexpr (mode == AddressMode::R_R) {
+      m_FetchedData = Reg<reg2>();
+    } else if constexpr (mode == AddressMode::R_D8) {
+      m_FetchedData = FetchOperand<predecoded>(0);
+      Cycle(1);
+      regs.pc++;
+    } else if constexpr (mode == AddressMode::R_D16 || mode == AddressMode::D16) {
+      uint16_t lo = FetchOperand<predecoded>(0);
+      Cycle(1);
 
-      case AddressMode::R:
-        m_FetchedData = Reg(m_CurrentInstruction->reg1);
-        return;
+      uint16_t hi = FetchOperand<predecoded>(1);
+      Cycle(1);
 
-      case AddressMode::R_R:
-        m_FetchedData = Reg(m_CurrentInstruction->reg2);
-        return;
+      m_FetchedData = lo | (hi << 8);
 
-      case AddressMode::R_D8:
-        m_FetchedData = bus.cpuRead(regs.pc);
-        Cycle(1);
-        regs.pc++;
-        return;
+      regs.pc += 2;
+    } else if constexpr (mode == AddressMode::MR_R) {
+      m_FetchedData = Reg<reg2>();
+      m_MemoryDestination = Reg<reg1>();
 
-      case AddressMode::R_D16:
-      case AddressMode::D16: {
-        uint16_t lo = bus.cpuRead(regs.pc);
-        Cycle(1);
+      if constexpr (reg1 == Register::C) {
+        m_MemoryDestination |= 0xFF00;
+      }
+    } else if constexpr (mode == AddressMode::R_MR) {
+      uint16_t addr = Reg<reg2>();
 
-        uint16_t hi = bus.cpuRead(regs.pc + 1);
-        Cycle(1);
+      if constexpr (reg2 == Register::C) {
+        addr |= 0xFF00;
+      }
 
-        m_FetchedData = lo | (hi << 8);
+      m_FetchedData = bus.cpuRead(addr);
+      Cycle(1);
+    } else if constexpr (mode == AddressMode::R_HLI) {
+      m_FetchedData = bus.cpuRead(Reg<reg2>());
+      Reg<Register::HL>(Reg<Register::HL>() + 1);
+      Cycle(1);
+    } else if constexpr (mode == AddressMode::R_HLD) {
+      m_FetchedData = bus.cpuRead(Reg<reg2>());
+      Reg<Register::HL>(Reg<Register::HL>() - 1);
+      Cycle(1);
+    } else if constexpr (mode == AddressMode::HLI_R) {
+      m_FetchedData = Reg<reg2>();
+      m_MemoryDestination = Reg<reg1>();
+      Reg<Register::HL>(Reg<Register::HL>() + 1);
+    } else if constexpr (mode == AddressMode::HLD_R) {
+      m_FetchedData = Reg<reg2>();
+      m_MemoryDestination = Reg<reg1>();
+      Reg<Register::HL>(Reg<Register::HL>() - 1);
+    } else if constexpr (mode == AddressMode::R_A8 ||
+                         mode == AddressMode::HL_SPR ||
+                         mode == AddressMode::D8) {
+      m_FetchedData = FetchOperand<predecoded>(0);
+      regs.pc++;
+      Cycle(1);
+    } else if constexpr (mode == AddressMode::A8_R) {
+      m_MemoryDestination = FetchOperand<predecoded>(0) | 0xFF00;
+      regs.pc++;
+      Cycle(1);
+    } else if constexpr (mode == AddressMode::A16_R || mode == AddressMode::D16_R) {
+      uint16_t lo = FetchOperand<predecoded>(0);
+      Cycle(1);
 
-        regs.pc += 2;
+      uint16_t hi = FetchOperand<predecoded>(1);
+      Cycle(1);
 
-        return;
-      }
+      m_MemoryDestination = lo | (hi << 8);
 
-      case AddressMode::MR_R:
-        m_FetchedData = Reg(m_CurrentInstruction->reg2);
-        m_MemoryDestination = Reg(m_CurrentInstruction->reg1);
-        DestinationIsMemory = true;
+      regs.pc += 2;
+      m_FetchedData = Reg<reg2>();
+    } else if constexpr (mode == AddressMode::MR_D8) {
+      m_FetchedData = FetchOperand<predecoded>(0);
+      m_MemoryDestination = Reg<reg1>();
+      Cycle(1);
+      regs.pc++;
+    } else if constexpr (mode == AddressMode::MR) {
+      m_MemoryDestination = Reg<reg1>();
+      m_FetchedData = bus.cpuRead(Reg<reg1>());
+      Cycle(1);
+    } else if constexpr (mode == AddressMode::R_A16) {
+      uint16_t lo = FetchOperand<predecoded>(0);
+      Cycle(1);
 
-        if (m_CurrentInstruction->reg1 == Register::C) {
-          m_MemoryDestination |= 0xFF00;
-        }
+      uint16_t hi = FetchOperand<predecoded>(1);
+      Cycle(1);
 
-        return;
+      uint16_t addr = lo | (hi << 8);
 
-      case AddressMode::R_MR: {
-        uint16_t addr = Reg(m_CurrentInstruction->reg2);
+      regs.pc += 2;
+      m_FetchedData = bus.cpuRead(addr);
+      Cycle(1);
+    }
+  }
 
-        if (m_CurrentInstruction->reg2 == Register::C) {
-          addr |= 0xFF00;
-        }
+  void SharpSM83::FetchInstruction() {
+    auto &bus = Gameboy::Get();
 
-        m_FetchedData = bus.cpuRead(addr);
-        Cycle(1);
+    m_CurrentOpcode = bus.cpuFetch(regs.pc++);
+    Cycle(1);
+  }
 
+  bool SharpSM83::FetchCachedInstruction() {
+    if (m_Block == nullptr ||
+        m_BlockGeneration != m_BlockCache.Generation() ||
+        m_BlockIndex >= m_Block->entries.size() ||
+        m_Block->entries[m_BlockIndex].pc != regs.pc) {
+      m_Block = m_BlockCache.Lookup(regs.pc);
+      m_BlockGeneration = m_BlockCache.Generation();
+      m_BlockIndex = 0;
+
+      if (m_Block == nullptr) {
+        return false;
       }
-        return;
-
-      case AddressMode::R_HLI:
-        m_FetchedData = bus.cpuRead(Reg(m_CurrentInstruction->reg2));
-        Reg(Register::HL, Reg(Register::HL) + 1);
-        Cycle(1);
-        return;
+    }
 
-      case AddressMode::R_HLD:
-        m_FetchedData = bus.cpuRead(Reg(m_CurrentInstruction->reg2));
-        Reg(Register::HL, Reg(Register::HL) - 1);
-        Cycle(1);
-        return;
-
-      case AddressMode::HLI_R:
-        m_FetchedData = Reg(m_CurrentInstruction->reg2);
-        m_MemoryDestination = Reg(m_CurrentInstruction->reg1);
-        DestinationIsMemory = true;
-        Reg(Register::HL, Reg(Register::HL) + 1);
-        return;
-
-      case AddressMode::HLD_R:
-        m_FetchedData = Reg(m_CurrentInstruction->reg2);
-        m_MemoryDestination = Reg(m_CurrentInstruction->reg1);
-        DestinationIsMemory = true;
-        Reg(Register::HL, Reg(Register::HL) - 1);
-        return;
-
-      case AddressMode::R_A8:
-        m_FetchedData = bus.cpuRead(regs.pc);
-        regs.pc++;
-        Cycle(1);
-        return;
+    const auto &entry = m_Block->entries[m_BlockIndex++];
 
-      case AddressMode::A8_R:
-        m_MemoryDestination = bus.cpuRead(regs.pc) | 0xFF00;
-        DestinationIsMemory = true;
-        regs.pc++;
-        Cycle(1);
-        return;
+    m_CurrentOpcode = entry.opcode;
+    m_Operand = entry.operand;
+    regs.pc++;
+    Cycle(1);
 
-      case AddressMode::HL_SPR:
-        m_FetchedData = bus.cpuRead(regs.pc);
-        regs.pc++;
-        Cycle(1);
-        return;
+    return true;
+  }
 
-      case AddressMode::D8:
-        m_FetchedData = bus.cpuRead(regs.pc);
-        regs.pc++;
-        Cycle(1);
-        return;
+  template<uint16_t index, bool predecoded>
+  void SharpSM83::Dispatch() {
+    if constexpr (index >= 0x100) {
+      ProcCB<index & 0xFF>();
+    } else {
+      constexpr const Instructions::Opcode &op = Instructions::OpcodeByByte(index);
+
+      FetchData<op.mode, op.reg1, op.reg2, predecoded>();
+
+      if constexpr (op.type == Instruction::NONE) {
+        ProcNone();
+      } else if constexpr (op.type == Instruction::NOP) {
+        ProcNOP();
+      } else if constexpr (op.type == Instruction::LD) {
+        ProcLD<index>();
+      } else if constexpr (op.type == Instruction::LDH) {
+        ProcLDH<index>();
+      } else if constexpr (op.type == Instruction::JP) {
+        ProcJP<index>();
+      } else if constexpr (op.type == Instruction::DI) {
+        ProcDI();
+      } else if constexpr (op.type == Instruction::POP) {
+        ProcPOP<index>();
+      } else if constexpr (op.type == Instruction::PUSH) {
+        ProcPUSH<index>();
+      } else if constexpr (op.type == Instruction::JR) {
+        ProcJR<index>();
+      } else if constexpr (op.type == Instruction::CALL) {
+        ProcCALL<index>();
+      } else if constexpr (op.type == Instruction::RET) {
+        ProcRET<index>();
+      } else if constexpr (op.type == Instruction::RST) {
+        ProcRST<index>();
+      } else if constexpr (op.type == Instruction::DEC) {
+        ProcDEC<index>();
+      } else if constexpr (op.type == Instruction::INC) {
+        ProcINC<index>();
+      } else if constexpr (op.type == Instruction::ADD) {
+        ProcADD<index>();
+      } else if constexpr (op.type == Instruction::ADC) {
+        ProcADC();
+      } else if constexpr (op.type == Instruction::SUB) {
+        ProcSUB<index>();
+      } else if constexpr (op.type == Instruction::SBC) {
+        ProcSBC<index>();
+      } else if constexpr (op.type == Instruction::AND) {
+        ProcAND();
+      } else if constexpr (op.type == Instruction::XOR) {
+        ProcXOR();
+      } else if constexpr (op.type == Instruction::OR) {
+        ProcOR();
+      } else if constexpr (op.type == Instruction::CP) {
+        ProcCP();
+      } else if constexpr (op.type == Instruction::CB) {
+        ProcCB();
+      } else if constexpr (op.type == Instruction::RRCA) {
+        ProcRRCA();
+      } else if constexpr (op.type == Instruction::RLCA) {
+        ProcRLCA();
+      } else if constexpr (op.type == Instruction::RRA) {
+        ProcRRA();
+      } else if constexpr (op.type == Instruction::RLA) {
+        ProcRLA();
+      } else if constexpr (op.type == Instruction::STOP) {
+        ProcSTOP();
+      } else if constexpr (op.type == Instruction::HALT) {
+        ProcHALT();
+      } else if constexpr (op.type == Instruction::DAA) {
+        ProcDAA();
+      } else if constexpr (op.type == Instruction::CPL) {
+        ProcCPL();
+      } else if constexpr (op.type == Instruction::SCF) {
+        ProcSCF();
+      } else if constexpr (op.type == Instruction::CCF) {
+        ProcCCF();
+      } else if constexpr (op.type == Instruction::EI) {
+        ProcEI();
+      } else if constexpr (op.type == Instruction::RETI) {
+        ProcRETI();
+      } else {
+        static_assert(op.type == Instruction::NONE, "No processor for instruction type");
+      }
+    }
+  }
 
-      case AddressMode::A16_R:
-      case AddressMode::D16_R: {
-        uint16_t lo = bus.cpuRead(regs.pc);
-        Cycle(1);
+  bool SharpSM83::Step() {
+    m_CurrentCycles = 0;
 
-        uint16_t hi = bus.cpuRead(regs.pc + 1);
-        Cycle(1);
+    if (!m_Halted) {
+      m_Instructions++;
 
-        m_MemoryDestination = lo | (hi << 8);
-        DestinationIsMemory = true;
+      if (m_UseBlockCache && FetchCachedInstruction()) {
+        m_CurrentCycles++;
 
-        regs.pc += 2;
-        m_FetchedData = Reg(m_CurrentInstruction->reg2);
+        (this->*m_PredecodedDispatch[m_CurrentOpcode])();
+      } else {
+        FetchInstruction();
+        m_CurrentCycles++;
 
+        (this->*m_Dispatch[m_CurrentOpcode])();
       }
-        return;
+    } else {
+      auto &bus = Gameboy::Get();
 
-      case AddressMode::MR_D8:
-        m_FetchedData = bus.cpuRead(regs.pc);
-        m_MemoryDestination = Reg(m_CurrentInstruction->reg1);
-        DestinationIsMemory = true;
-        Cycle(1);
-        regs.pc++;
-        return;
+      // Only the clock moves until a peripheral raises an interrupt, so a
+      // settled HALT runs straight up to the next scheduler deadline
+      uint32_t cycles = (m_IF || m_EnablingIME) ? 1 : bus.HaltCycles();
 
-      case AddressMode::MR:
-        m_MemoryDestination = Reg(m_CurrentInstruction->reg1);
-        DestinationIsMemory = true;
-        m_FetchedData = bus.cpuRead(Reg(m_CurrentInstruction->reg1));
-        Cycle(1);
-        return;
+      m_HaltStats.cycles += cycles;
+      m_HaltStats.skipped += cycles - 1;
 
-      case AddressMode::R_A16: {
-        uint16_t lo = bus.cpuRead(regs.pc);
-        Cycle(1);
+      m_CurrentCycles++;
+      bus.Cycles(cycles);
 
-        uint16_t hi = bus.cpuRead(regs.pc + 1);
-        Cycle(1);
+      if (m_IF) {
+        m_Halted = false;
+      }
+    }
 
-        uint16_t addr = lo | (hi << 8);
+    FinishStep();
 
-        regs.pc += 2;
-        m_FetchedData = bus.cpuRead(addr);
-        Cycle(1);
+    return true;
+  }
 
-        return;
-      }
+  void SharpSM83::FinishStep() {
+    if (m_InterruptMasterEnabled) {
+      Interrupts::HandleInterrupts(*this);
+      m_EnablingIME = false;
+    }
 
-      default:
-        printf("Unknown Addressing Mode! %d (%02X)\n", m_CurrentInstruction->mode, m_CurrentOpcode);
-        exit(-7);
+    if (m_EnablingIME) {
+      m_InterruptMasterEnabled = true;
     }
   }
 
-  void SharpSM83::FetchInstruction() {
+  bool SharpSM83::RunCompiled() {
     auto &bus = Gameboy::Get();
 
-    m_CurrentOpcode = bus.cpuRead(regs.pc++);
-    m_CurrentInstruction = &instrs.OpcodeByByte(m_CurrentOpcode);
-    Cycle(1);
+    if (!m_UseJit || m_Halted || regs.pc >= 0x8000 || bus.m_TargetActive) {
+      return false;
+    }
+
+    const auto *block = m_BlockCache.Lookup(regs.pc);
+
+    if (block == nullptr) {
+      return false;
+    }
+
+    auto code = m_Jit.Lookup(*block, m_CompiledHandlers);
+    m_JitGeneration = m_BlockCache.Generation();
+
+    if (code == nullptr) {
+      InterpretBlock(*block);
+    } else if (m_JitLockstep) {
+      RunLockstep(*block, code);
+    } else {
+      RunNative(code);
+    }
+
+    return true;
   }
 
-  void SharpSM83::Execute() {
-    auto proc = GetProcessor(m_CurrentInstruction->type);
+  template<uint8_t opcode>
+  int32_t SharpSM83::ExecuteCompiled(SharpSM83 *cpu, uint32_t operand, uint32_t pending) {
+    uint16_t next = cpu->regs.pc + Instructions::OpcodeByByte(opcode).length;
 
-    if (!proc) {
-      spdlog::get("console")->warn("No processor for current instruction: {:02X}", m_CurrentInstruction->code);
-      return;
+    if (pending) {
+      Gameboy::Get().Cycles(pending);
     }
 
-    (this->*proc)();
+    cpu->m_CurrentCycles = 0;
+    cpu->m_CurrentOpcode = opcode;
+    cpu->m_Operand = operand;
+    cpu->m_Instructions++;
+    cpu->regs.pc++;
+    cpu->Cycle(1);
+    cpu->m_CurrentCycles++;
+
+    cpu->Dispatch<opcode, true>();
+    cpu->FinishStep();
+
+    return cpu->ContinueBlock(next) ? static_cast<int32_t>(cpu->NativeBudget()) : Jit::Stop;
   }
 
-  bool SharpSM83::Step() {
-    m_CurrentCycles = 0;
+  uint32_t SharpSM83::NativeBudget() const {
+    // Native instructions skip FinishStep(), which only has work to do right
+    // after EI or with an interrupt waiting to be taken
+    if (m_EnablingIME || (m_InterruptMasterEnabled && (m_IF & m_IE & 0x1F))) {
+      return 0;
+    }
 
-    if (!m_Halted) {
-      FetchInstruction();
-      m_CurrentCycles++;
+    return Gameboy::Get().QuietCycles();
+  }
 
-      FetchData();
+  bool SharpSM83::ContinueBlock(uint16_t next) const {
+    // Keep going only while the next instruction is the one this block
+    // decoded and Gameboy::Update() would have started another step
+    return regs.pc == next &&
+           !m_Halted &&
+           m_JitGeneration == m_BlockCache.Generation() &&
+           Gameboy::Get().m_MCycleCount <= Gameboy::MCyclesPerFrame;
+  }
 
-      if (m_CurrentInstruction == nullptr) {
-        m_Halted = true;
-        spdlog::get("console")->warn("No instructions for opcode {}", m_CurrentOpcode);
+  void SharpSM83::InterpretBlock(const BlockCache::Block &block) {
+    for (const auto &entry: block.entries) {
+      if (m_CompiledHandlers[entry.opcode](this, entry.operand, 0) == Jit::Stop) {
+        break;
       }
+    }
+  }
 
-      Execute();
-    } else {
-      Cycle(1);
+  void SharpSM83::RunNative(Jit::CompiledBlock code) {
+    Jit::Frame frame{&regs, NativeBudget()};
 
-      if (m_IF) {
-        m_Halted = false;
-      }
+    code(this, &frame);
+
+    // The budget kept every deadline out of reach, so the cycles of the
+    // native instructions after the last handler go to the bus in one go
+    if (frame.pending) {
+      Gameboy::Get().Cycles(frame.pending);
     }
 
-    if (m_InterruptMasterEnabled) {
-      Interrupts::HandleInterrupts(*this);
-      m_EnablingIME = false;
+    m_Instructions += frame.instructions;
+  }
+
+  void SharpSM83::StepBlock(const BlockCache::Block &block) {
+    bool useBlockCache = m_UseBlockCache;
+
+    // Fetch and decode through m_Dispatch rather than the predecoded entries
+    m_UseBlockCache = false;
+
+    for (const auto &entry: block.entries) {
+      Step();
+
+      if (!ContinueBlock(entry.pc + entry.length)) {
+        break;
+      }
     }
 
-    if (m_EnablingIME) {
-      m_InterruptMasterEnabled = true;
+    m_UseBlockCache = useBlockCache;
+  }
+
+  void SharpSM83::RunLockstep(const BlockCache::Block &block, Jit::CompiledBlock code) {
+    auto &bus = Gameboy::Get();
+    auto &stats = m_Jit.GetStats();
+
+    State before = CaptureState();
+
+    bus.BeginBusRecord();
+    StepBlock(block);
+    State expected = CaptureState();
+    uint64_t instructions = m_Instructions;
+
+    RestoreState(before);
+    bus.BeginBusReplay();
+    RunNative(code);
+    bool busMatched = bus.EndBusReplay();
+    State actual = CaptureState();
+
+    RestoreState(expected);
+    m_Instructions = instructions;
+    m_JitGeneration = m_BlockCache.Generation();
+
+    stats.lockstepChecks++;
+
+    if (!busMatched || !SameState(expected, actual)) {
+      stats.divergences++;
+
+      spdlog::get("console")->warn(
+          "Jit: block {:04X} (bank {}) diverged from the interpreter{}",
+          block.start, block.bank, busMatched ? "" : " (bus access or timing mismatch)");
+      spdlog::get("console")->warn(
+          "  interpreter: AF={:02X}{:02X} BC={:02X}{:02X} DE={:02X}{:02X} HL={:02X}{:02X} SP={:04X} PC={:04X}",
+          expected.regs.a, expected.regs.f, expected.regs.b, expected.regs.c,
+          expected.regs.d, expected.regs.e, expected.regs.h, expected.regs.l,
+          expected.regs.sp, expected.regs.pc);
+      spdlog::get("console")->warn(
+          "  jit:         AF={:02X}{:02X} BC={:02X}{:02X} DE={:02X}{:02X} HL={:02X}{:02X} SP={:04X} PC={:04X}",
+          actual.regs.a, actual.regs.f, actual.regs.b, actual.regs.c,
+          actual.regs.d, actual.regs.e, actual.regs.h, actual.regs.l,
+          actual.regs.sp, actual.regs.pc);
     }
+  }
 
-    return true;
+  SharpSM83::State SharpSM83::CaptureState() const {
+    return {regs, m_Halted, m_InterruptMasterEnabled, m_EnablingIME, m_IE, m_IF};
+  }
+
+  void SharpSM83::RestoreState(const State &state) {
+    regs = state.regs;
+    m_Halted = state.halted;
+    m_InterruptMasterEnabled = state.ime;
+    m_EnablingIME = state.enablingIME;
+    m_IE = state.ie;
+    m_IF = state.intFlags;
+  }
+
+  bool SharpSM83::SameState(const State &a, const State &b) {
+    return a.regs.a == b.regs.a && a.regs.f == b.regs.f &&
+           a.regs.b == b.regs.b && a.regs.c == b.regs.c &&
+           a.regs.d == b.regs.d && a.regs.e == b.regs.e &&
+           a.regs.h == b.regs.h && a.regs.l == b.regs.l &&
+           a.regs.pc == b.regs.pc && a.regs.sp == b.regs.sp &&
+           a.halted == b.halted && a.ime == b.ime &&
+           a.enablingIME == b.enablingIME &&
+           a.ie == b.ie && a.intFlags == b.intFlags;
   }
 
   void SharpSM83::SetFlags(int8_t z, int8_t n, int8_t h, int8_t c) {
@@ -425,49 +749,29 @@ namespace hijo {
     }
   }
 
-  Register SharpSM83::DecodeRegister(uint8_t reg) {
-    if (reg > 0x7) {
-      return Register::NONE;
-    }
-
-    return m_RegisterTypes[reg];
-  }
-
-  bool SharpSM83::Is16Bit(const Register &t) {
-    return static_cast<uint8_t>(t) > static_cast<uint8_t>(Register::AF);
-  }
-
+  template<Condition cond>
   bool SharpSM83::CheckCondition() {
-    uint8_t z = CPU_FLAG_Z();
-    uint8_t c = CPU_FLAG_C();
-
-    switch (m_CurrentInstruction->cond) {
-      case Condition::NONE:
-        return true;
-      case Condition::C:
-        return c;
-      case Condition::NC:
-        return !c;
-      case Condition::Z:
-        return z;
-      case Condition::NZ:
-        return !z;
+    if constexpr (cond == Condition::NONE) {
+      return true;
+    } else if constexpr (cond == Condition::C) {
+      return CPU_FLAG_C();
+    } else if constexpr (cond == Condition::NC) {
+      return !CPU_FLAG_C();
+    } else if constexpr (cond == Condition::Z) {
+      return CPU_FLAG_Z();
+    } else {
+      return !CPU_FLAG_Z();
     }
-
-    return false;
   }
 
+  template<Condition cond>
   void SharpSM83::GotoAddress(uint16_t addr, bool pushPC) {
-    if (CheckCondition()) {
+    if (CheckCondition<cond>()) {
       if (pushPC) {
         Cycle(2);
         Stack::Push16(regs.pc);
       }
 
-      /* if (addr >= 0xC000 && addr < 0xFE00) {
-         Disassemble(0, 0xFFFF);
-       }*/
-
       regs.pc = addr;
       Cycle(1);
     }
@@ -482,122 +786,110 @@ namespace hijo {
   }
 
   void SharpSM83::ProcCB() {
-    uint8_t op = m_FetchedData;
-    Register reg = DecodeRegister(op & 0b111);
-    uint8_t bit = (op >> 3) & 0b111;
-    uint8_t bit_op = (op >> 6) & 0b11;
-    uint8_t reg_val = Reg8(reg);
+    (this->*m_Dispatch[0x100 | (m_FetchedData & 0xFF)])();
+  }
+
+  template<uint8_t op>
+  void SharpSM83::ProcCB() {
+    constexpr Register registerTypes[] = {
+        Register::B,
+        Register::C,
+        Register::D,
+        Register::E,
+        Register::H,
+        Register::L,
+        Register::HL,
+        Register::A
+    };
+
+    constexpr Register reg = registerTypes[op & 0b111];
+    constexpr uint8_t bit = (op >> 3) & 0b111;
+    constexpr uint8_t bit_op = (op >> 6) & 0b11;
+    uint8_t reg_val = Reg8<reg>();
 
     Cycle(1);
 
-    if (reg == Register::HL) {
+    if constexpr (reg == Register::HL) {
       Cycle(2);
     }
 
-    switch (bit_op) {
-      case 1:
-        //BIT
-        SetFlags(!(reg_val & (1 << bit)), 0, 1, -1);
-        return;
-
-      case 2:
-        //RST
-        reg_val &= ~(1 << bit);
-        Reg8(reg, reg_val);
-        return;
-
-      case 3:
-        //SET
-        reg_val |= (1 << bit);
-        Reg8(reg, reg_val);
-        return;
+    if constexpr (bit_op == 1) {
+      //BIT
+      SetFlags(!(reg_val & (1 << bit)), 0, 1, -1);
+      return;
+    } else if constexpr (bit_op == 2) {
+      //RST
+      reg_val &= ~(1 << bit);
+      Reg8<reg>(reg_val);
+      return;
+    } else if constexpr (bit_op == 3) {
+      //SET
+      reg_val |= (1 << bit);
+      Reg8<reg>(reg_val);
+      return;
     }
 
     bool flagC = CPU_FLAG_C();
 
-    switch (bit) {
-      case 0: {
-        //RLC
-        bool setC = false;
-        uint8_t result = (reg_val << 1) & 0xFF;
-
-        if ((reg_val & (1 << 7)) != 0) {
-          result |= 1;
-          setC = true;
-        }
-
-        Reg8(reg, result);
-        SetFlags(result == 0, false, false, setC);
-      }
-        return;
-
-      case 1: {
-        //RRC
-        uint8_t old = reg_val;
-        reg_val >>= 1;
-        reg_val |= (old << 7);
-
-        Reg8(reg, reg_val);
-        SetFlags(!reg_val, false, false, old & 1);
-      }
-        return;
-
-      case 2: {
-        //RL
-        uint8_t old = reg_val;
-        reg_val <<= 1;
-        reg_val |= flagC;
-
-        Reg8(reg, reg_val);
-        SetFlags(!reg_val, false, false, !!(old & 0x80));
-      }
-        return;
-
-      case 3: {
-        //RR
-        uint8_t old = reg_val;
-        reg_val >>= 1;
-
-        reg_val |= (flagC << 7);
-
-        Reg8(reg, reg_val);
-        SetFlags(!reg_val, false, false, old & 1);
-      }
-        return;
-
-      case 4: {
-        //SLA
-        uint8_t old = reg_val;
-        reg_val <<= 1;
-
-        Reg8(reg, reg_val);
-        SetFlags(!reg_val, false, false, !!(old & 0x80));
-      }
-        return;
-
-      case 5: {
-        //SRA
-        uint8_t u = (int8_t) reg_val >> 1;
-        Reg8(reg, u);
-        SetFlags(!u, 0, 0, reg_val & 1);
-      }
-        return;
+    if constexpr (bit == 0) {
+      //RLC
+      bool setC = false;
+      uint8_t result = (reg_val << 1) & 0xFF;
 
-      case 6: {
-        //SWAP
-        reg_val = ((reg_val & 0xF0) >> 4) | ((reg_val & 0xF) << 4);
-        Reg8(reg, reg_val);
-        SetFlags(reg_val == 0, false, false, false);
+      if ((reg_val & (1 << 7)) != 0) {
+        result |= 1;
+        setC = true;
       }
-        return;
 
-      case 7: {
-        //SRL
-        uint8_t u = reg_val >> 1;
-        Reg8(reg, u);
-        SetFlags(!u, 0, 0, reg_val & 1);
-      }
-        return;
+      Reg8<reg>(result);
+      SetFlags(result == 0, false, false, setC);
+    } else if constexpr (bit == 1) {
+      //RRC
+      uint8_t old = reg_val;
+      reg_val >>= 1;
+      reg_val |= (old << 7);
+
+      Reg8<reg>(reg_val);
+      SetFlags(!reg_val, false, false, old & 1);
+    } else if constexpr (bit == 2) {
+      //RL
+      uint8_t old = reg_val;
+      reg_val <<= 1;
+      reg_val |= flagC;
+
+      Reg8<reg>(reg_val);
+      SetFlags(!reg_val, false, false, !!(old & 0x80));
+    } else if constexpr (bit == 3) {
+      //RR
+      uint8_t old = reg_val;
+      reg_val >>= 1;
+
+      reg_val |= (flagC << 7);
+
+      Reg8<reg>(reg_val);
+      SetFlags(!reg_val, false, false, old & 1);
+    } else if constexpr (bit == 4) {
+      //SLA
+      uint8_t old = reg_val;
+      reg_val <<= 1;
+
+      Reg8<reg>(reg_val);
+      SetFlags(!reg_val, false, false, !!(old & 0x80));
+    } else if constexpr (bit == 5) {
+      //SRA
+      uint8_t u = (int8_t) reg_val >> 1;
+      Reg8<reg>(u);
+      SetFlags(!u, 0, 0, reg_val & 1);
+    } else if constexpr (bit == 6) {
+      //SWAP
+      reg_val = ((reg_val & 0xF0) >> 4) | ((reg_val & 0xF) << 4);
+      Reg8<reg>(reg_val);
+      SetFlags(reg_val == 0, false, false, false);
+    } else {
+      //SRL
+      uint8_t u = reg_val >> 1;
+      Reg8<reg>(u);
+      SetFlags(!u, 0, 0, reg_val & 1);
     }
   }
 
@@ -706,10 +998,20 @@ namespace hijo {
     m_EnablingIME = true;
   }
 
+  template<uint8_t op>
   void SharpSM83::ProcLD() {
+    constexpr const Instructions::Opcode &instr = Instructions::OpcodeByByte(op);
     auto &bus = Gameboy::Get();
-    if (DestinationIsMemory) {
-      if (Is16Bit(m_CurrentInstruction->reg2)) {
+
+    if constexpr (instr.mode == AddressMode::MR_R ||
+                  instr.mode == AddressMode::HLI_R ||
+                  instr.mode == AddressMode::HLD_R ||
+                  instr.mode == AddressMode::A8_R ||
+                  instr.mode == AddressMode::A16_R ||
+                  instr.mode == AddressMode::D16_R ||
+                  instr.mode == AddressMode::MR_D8 ||
+                  instr.mode == AddressMode::MR) {
+      if constexpr (Is16Bit(instr.reg2)) {
         Cycle(1);
         bus.cpuWrite16(m_MemoryDestination, m_FetchedData);
       } else {
@@ -717,31 +1019,27 @@ namespace hijo {
       }
 
       Cycle(1);
-
-      return;
-    }
-
-    if (m_CurrentInstruction->mode == AddressMode::HL_SPR) {
-      uint8_t hflag = (Reg(m_CurrentInstruction->reg2) & 0xF) +
+    } else if constexpr (instr.mode == AddressMode::HL_SPR) {
+      uint8_t hflag = (Reg<instr.reg2>() & 0xF) +
                       (m_FetchedData & 0xF) >= 0x10;
 
-      uint8_t cflag = (Reg(m_CurrentInstruction->reg2) & 0xFF) +
+      uint8_t cflag = (Reg<instr.reg2>() & 0xFF) +
                       (m_FetchedData & 0xFF) >= 0x100;
 
       SetFlags(0, 0, hflag, cflag);
-      Reg(m_CurrentInstruction->reg1,
-          Reg(m_CurrentInstruction->reg2) + (int8_t) m_FetchedData);
-
-      return;
+      Reg<instr.reg1>(Reg<instr.reg2>() + (int8_t) m_FetchedData);
+    } else {
+      Reg<instr.reg1>(m_FetchedData);
     }
-
-    Reg(m_CurrentInstruction->reg1, m_FetchedData);
   }
 
+  template<uint8_t op>
   void SharpSM83::ProcLDH() {
+    constexpr const Instructions::Opcode &instr = Instructions::OpcodeByByte(op);
     auto &bus = Gameboy::Get();
-    if (m_CurrentInstruction->reg1 == Register::A) {
-      Reg(m_CurrentInstruction->reg1, bus.cpuRead(0xFF00 | m_FetchedData));
+
+    if constexpr (instr.reg1 == Register::A) {
+      Reg<instr.reg1>(bus.cpuRead(0xFF00 | m_FetchedData));
     } else {
       bus.cpuWrite(m_MemoryDestination, regs.a);
     }
@@ -749,30 +1047,38 @@ namespace hijo {
     Cycle(1);
   }
 
+  template<uint8_t op>
   void SharpSM83::ProcJP() {
-    GotoAddress(m_FetchedData, false);
+    GotoAddress<Instructions::OpcodeByByte(op).cond>(m_FetchedData, false);
   }
 
+  template<uint8_t op>
   void SharpSM83::ProcJR() {
     int8_t rel = (int8_t) (m_FetchedData & 0xFF);
     uint16_t addr = regs.pc + rel;
-    GotoAddress(addr, false);
+    GotoAddress<Instructions::OpcodeByByte(op).cond>(addr, false);
   }
 
+  template<uint8_t op>
   void SharpSM83::ProcCALL() {
-    GotoAddress(m_FetchedData, true);
+    GotoAddress<Instructions::OpcodeByByte(op).cond>(m_FetchedData, true);
   }
 
+  template<uint8_t op>
   void SharpSM83::ProcRST() {
-    GotoAddress(m_CurrentInstruction->param, true);
+    constexpr const Instructions::Opcode &instr = Instructions::OpcodeByByte(op);
+    GotoAddress<instr.cond>(instr.param, true);
   }
 
+  template<uint8_t op>
   void SharpSM83::ProcRET() {
-    if (m_CurrentInstruction->cond != Condition::NONE) {
+    constexpr Condition cond = Instructions::OpcodeByByte(op).cond;
+
+    if constexpr (cond != Condition::NONE) {
       Cycle(1);
     }
 
-    if (CheckCondition()) {
+    if (CheckCondition<cond>()) {
       uint16_t lo = Stack::Pop();
       Cycle(1);
       uint16_t hi = Stack::Pop();
@@ -787,10 +1093,13 @@ namespace hijo {
 
   void SharpSM83::ProcRETI() {
     m_InterruptMasterEnabled = true;
-    ProcRET();
+    ProcRET<0xD9>();
   }
 
+  template<uint8_t op>
   void SharpSM83::ProcPOP() {
+    constexpr Register reg = Instructions::OpcodeByByte(op).reg1;
+
     uint16_t lo = Stack::Pop();
     Cycle(1);
     uint16_t hi = Stack::Pop();
@@ -798,102 +1107,115 @@ namespace hijo {
 
     uint16_t n = (hi << 8) | lo;
 
-    if (m_CurrentInstruction->reg1 == Register::AF) {
-      Reg(m_CurrentInstruction->reg1, n & 0xFFF0);
+    if constexpr (reg == Register::AF) {
+      Reg<reg>(n & 0xFFF0);
     } else {
-      Reg(m_CurrentInstruction->reg1, n);
+      Reg<reg>(n);
     }
   }
 
+  template<uint8_t op>
   void SharpSM83::ProcPUSH() {
+    constexpr Register reg = Instructions::OpcodeByByte(op).reg1;
+
     // Internal
     Cycle(1);
 
-    uint16_t hi = (Reg(m_CurrentInstruction->reg1) >> 8) & 0xFF;
+    uint16_t hi = (Reg<reg>() >> 8) & 0xFF;
     Cycle(1);
     Stack::Push(hi);
 
-    uint16_t lo = Reg(m_CurrentInstruction->reg1) & 0xFF;
+    uint16_t lo = Reg<reg>() & 0xFF;
     Cycle(1);
     Stack::Push(lo);
   }
 
+  template<uint8_t op>
   void SharpSM83::ProcINC() {
+    constexpr const Instructions::Opcode &instr = Instructions::OpcodeByByte(op);
     auto &bus = Gameboy::Get();
 
-    uint16_t val = Reg(m_CurrentInstruction->reg1) + 1;
+    uint16_t val = Reg<instr.reg1>() + 1;
 
-    if (Is16Bit(m_CurrentInstruction->reg1)) {
+    if constexpr (Is16Bit(instr.reg1)) {
       Cycle(1);
     }
 
-    if (m_CurrentInstruction->reg1 == Register::HL && m_CurrentInstruction->mode == AddressMode::MR) {
+    if constexpr (instr.reg1 == Register::HL && instr.mode == AddressMode::MR) {
       val = m_FetchedData;
       val++;
       val &= 0xFF;
-      bus.cpuWrite(Reg(Register::HL), val);
+      bus.cpuWrite(Reg<Register::HL>(), val);
       Cycle(1);
     } else {
-      Reg(m_CurrentInstruction->reg1, val);
-      val = Reg(m_CurrentInstruction->reg1);
+      Reg<instr.reg1>(val);
+      val = Reg<instr.reg1>();
     }
 
-    if ((m_CurrentOpcode & 0x03) == 0x03) {
+    if constexpr ((op & 0x03) == 0x03) {
       return;
     }
 
     SetFlags(val == 0, 0, (val & 0x0F) == 0, -1);
   }
 
+  template<uint8_t op>
   void SharpSM83::ProcDEC() {
+    constexpr const Instructions::Opcode &instr = Instructions::OpcodeByByte(op);
     auto &bus = Gameboy::Get();
 
-    uint16_t val = Reg(m_CurrentInstruction->reg1) - 1;
+    uint16_t val = Reg<instr.reg1>() - 1;
 
-    if (Is16Bit(m_CurrentInstruction->reg1)) {
+    if constexpr (Is16Bit(instr.reg1)) {
       Cycle(1);
     }
 
-    if (m_CurrentInstruction->reg1 == Register::HL && m_CurrentInstruction->mode == AddressMode::MR) {
+    if constexpr (instr.reg1 == Register::HL && instr.mode == AddressMode::MR) {
       val = m_FetchedData;
       val--;
       val &= 0xFF;
-      bus.cpuWrite(Reg(Register::HL), val);
+      bus.cpuWrite(Reg<Register::HL>(), val);
       Cycle(1);
     } else {
-      Reg(m_CurrentInstruction->reg1, val);
-      val = Reg(m_CurrentInstruction->reg1);
+      Reg<instr.reg1>(val);
+      val = Reg<instr.reg1>();
     }
 
-    if ((m_CurrentOpcode & 0x0B) == 0x0B) {
+    if constexpr ((op & 0x0B) == 0x0B) {
       return;
     }
 
     SetFlags(val == 0, 1, (val & 0x0F) == 0x0F, -1);
   }
 
+  template<uint8_t op>
   void SharpSM83::ProcSUB() {
-    uint16_t val = Reg(m_CurrentInstruction->reg1) - m_FetchedData;
+    constexpr Register reg = Instructions::OpcodeByByte(op).reg1;
+
+    uint16_t val = Reg<reg>() - m_FetchedData;
 
     int z = val == 0;
-    int h = ((int) Reg(m_CurrentInstruction->reg1) & 0xF) - ((int) m_FetchedData & 0xF) < 0;
-    int c = ((int) Reg(m_CurrentInstruction->reg1)) - ((int) m_FetchedData) < 0;
+    int h = ((int) Reg<reg>() & 0xF) - ((int) m_FetchedData & 0xF) < 0;
+    int c = ((int) Reg<reg>()) - ((int) m_FetchedData) < 0;
 
-    Reg(m_CurrentInstruction->reg1, val);
+    Reg<reg>(val);
     SetFlags(z, 1, h, c);
   }
 
+  template<uint8_t op>
   void SharpSM83::ProcSBC() {
+    constexpr Register reg = Instructions::OpcodeByByte(op).reg1;
+
     uint8_t val = m_FetchedData + CPU_FLAG_C();
 
-    int z = Reg(m_CurrentInstruction->reg1) - val == 0;
+    int z = Reg<reg>() - val == 0;
 
-    int h = ((int) Reg(m_CurrentInstruction->reg1) & 0xF)
+    int h = ((int) Reg<reg>() & 0xF)
             - ((int) m_FetchedData & 0xF) - ((int) CPU_FLAG_C()) < 0;
-    int c = ((int) Reg(m_CurrentInstruction->reg1))
+    int c = ((int) Reg<reg>())
             - ((int) m_FetchedData) - ((int) CPU_FLAG_C()) < 0;
 
-    Reg(m_CurrentInstruction->reg1, Reg(m_CurrentInstruction->reg1) - val);
+    Reg<reg>(Reg<reg>() - val);
     SetFlags(z, 1, h, c);
   }
 
@@ -909,40 +1231,63 @@ namespace hijo {
              a + u + c > 0xFF);
   }
 
+  template<uint8_t op>
   void SharpSM83::ProcADD() {
-    uint32_t val = Reg(m_CurrentInstruction->reg1) + m_FetchedData;
+    constexpr Register reg = Instructions::OpcodeByByte(op).reg1;
+
+    uint32_t val = Reg<reg>() + m_FetchedData;
 
-    bool is_16bit = Is16Bit(m_CurrentInstruction->reg1);
+    constexpr bool is_16bit = Is16Bit(reg);
 
-    if (is_16bit) {
+    if constexpr (is_16bit) {
       Cycle(1);
     }
 
-    if (m_CurrentInstruction->reg1 == Register::SP) {
-      val = Reg(m_CurrentInstruction->reg1) + (int8_t) m_FetchedData;
+    if constexpr (reg == Register::SP) {
+      val = Reg<reg>() + (int8_t) m_FetchedData;
     }
 
     int z = (val & 0xFF) == 0;
-    int h = (Reg(m_CurrentInstruction->reg1) & 0xF) + (m_FetchedData & 0xF) >= 0x10;
-    int c = (int) (Reg(m_CurrentInstruction->reg1) & 0xFF) + (int) (m_FetchedData & 0xFF) >= 0x100;
+    int h = (Reg<reg>() & 0xF) + (m_FetchedData & 0xF) >= 0x10;
+    int c = (int) (Reg<reg>() & 0xFF) + (int) (m_FetchedData & 0xFF) >= 0x100;
 
-    if (is_16bit) {
+    if constexpr (is_16bit) {
       z = -1;
-      h = (Reg(m_CurrentInstruction->reg1) & 0xFFF) + (m_FetchedData & 0xFFF) >= 0x1000;
-      uint32_t n = ((uint32_t) Reg(m_CurrentInstruction->reg1)) + ((uint32_t) m_FetchedData);
+      h = (Reg<reg>() & 0xFFF) + (m_FetchedData & 0xFFF) >= 0x1000;
+      uint32_t n = ((uint32_t) Reg<reg>()) + ((uint32_t) m_FetchedData);
       c = n >= 0x10000;
     }
 
-    if (m_CurrentInstruction->reg1 == Register::SP) {
+    if constexpr (reg == Register::SP) {
       z = 0;
-      h = (Reg(m_CurrentInstruction->reg1) & 0xF) + (m_FetchedData & 0xF) >= 0x10;
-      c = (int) (Reg(m_CurrentInstruction->reg1) & 0xFF) + (int) (m_FetchedData & 0xFF) >= 0x100;
+      h = (Reg<reg>() & 0xF) + (m_FetchedData & 0xF) >= 0x10;
+      c = (int) (Reg<reg>() & 0xFF) + (int) (m_FetchedData & 0xFF) >= 0x100;
     }
 
-    Reg(m_CurrentInstruction->reg1, val & 0xFFFF);
+    Reg<reg>(val & 0xFFFF);
     SetFlags(z, 0, h, c);
   }
 
+  template<bool predecoded, size_t... index>
+  constexpr std::array<SharpSM83::InstructionProc, sizeof...(index)>
+  SharpSM83::MakeDispatchTable(std::index_sequence<index...>) {
+    return {{&SharpSM83::Dispatch<index, predecoded>...}};
+  }
+
+  const SharpSM83::DispatchTable SharpSM83::m_Dispatch =
+      SharpSM83::MakeDispatchTable<false>(std::make_index_sequence<SharpSM83::DispatchSize>());
+
+  const SharpSM83::PredecodedDispatchTable SharpSM83::m_PredecodedDispatch =
+      SharpSM83::MakeDispatchTable<true>(std::make_index_sequence<256>());
+
+  template<size_t... index>
+  constexpr Jit::HandlerTable SharpSM83::MakeHandlerTable(std::index_sequence<index...>) {
+    return {{&SharpSM83::ExecuteCompiled<index>...}};
+  }
+
+  const Jit::HandlerTable SharpSM83::m_CompiledHandlers =
+      SharpSM83::MakeHandlerTable(std::make_index_sequence<256>());
+
   uint16_t SharpSM83::reverse(uint16_t n) {
     return ((n & 0xFF00) >> 8) | ((n & 0x00FF) << 8);
   }
@@ -956,7 +1301,7 @@ namespace hijo {
     uint16_t index = 0;
     while (start_addr < end_addr) {
       auto byte = bus.cpuRead(start_addr);
-      auto &op = instrs.OpcodeByByte(byte);
+      const auto &op = instrs.OpcodeByByte(byte);
 
       std::string bytes = fmt::format("{:02X}", op.code);
       std::string code = op.name;
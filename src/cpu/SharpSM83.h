@@ -1,13 +1,16 @@
 #pragma once
 
+#include <array>
 #include <cstdint>
+#include <utility>
 #include <vector>
-#include <unordered_map>
-#include <functional>
 #include <spdlog/spdlog.h>
 
 #include "common/common.h"
 #include "Instructions.h"
+#include "BlockCache.h"
+#include "IdleLoop.h"
+#include "Jit.h"
 
 #include "Stack.h"
 
@@ -28,6 +31,11 @@ namespace hijo {
       uint16_t sp;
     };
 
+    struct HaltStats {
+      uint64_t cycles = 0;
+      uint64_t skipped = 0;
+    };
+
     struct DisassemblyLine {
       uint16_t addr;
       uint16_t index;
@@ -69,6 +77,81 @@ namespace hijo {
 
     void Disassemble(uint16_t start_addr, uint16_t end_addr);
 
+    bool UsingBlockCache() const {
+      return m_UseBlockCache;
+    }
+
+    void UseBlockCache(bool enabled);
+
+    const BlockCache::Stats &BlockCacheStats() const {
+      return m_BlockCache.GetStats();
+    }
+
+    bool UsingJit() const {
+      return m_UseJit;
+    }
+
+    void UseJit(bool enabled) {
+      m_UseJit = enabled && Jit::Supported();
+    }
+
+    bool UsingJitLockstep() const {
+      return m_JitLockstep;
+    }
+
+    // Runs every compiled block through Step() first, then replays the block's
+    // bus traffic to the native code and reports where the two disagree
+    void UseJitLockstep(bool enabled) {
+      m_JitLockstep = enabled;
+    }
+
+    Jit::Stats &JitStats() {
+      return m_Jit.GetStats();
+    }
+
+    // Runs the ROM block at PC through the JIT backend. Returns false when the
+    // next instruction has to go through Step() instead.
+    bool RunCompiled();
+
+    // Instructions executed since the last reset, interpreted or compiled
+    uint64_t InstructionCount() const {
+      return m_Instructions;
+    }
+
+    // M-cycles spent halted, and how many of them were fast-forwarded
+    const HaltStats &GetHaltStats() const {
+      return m_HaltStats;
+    }
+
+    bool UsingIdleLoopSkip() const {
+      return m_UseIdleLoops;
+    }
+
+    // Fast-forwards loops that only poll PPU or timer registers
+    void UseIdleLoopSkip(bool enabled) {
+      m_UseIdleLoops = enabled;
+      m_IdleLoop.Forget();
+    }
+
+    bool VerifyingIdleLoops() const {
+      return m_IdleLoop.Verifying();
+    }
+
+    // Keeps interpreting detected loops and checks the skip would have matched
+    void VerifyIdleLoops(bool enabled) {
+      m_IdleLoop.Verify(enabled);
+    }
+
+    const IdleLoop::Stats &IdleLoopStats() const {
+      return m_IdleLoop.GetStats();
+    }
+
+    void SkipIdleLoop() {
+      if (m_UseIdleLoops && !m_Halted) {
+        m_IdleLoop.Check(*this);
+      }
+    }
+
   private:
     friend class Gameboy;
 
@@ -82,28 +165,97 @@ namespace hijo {
 
     friend class Stack;
 
+    friend class IdleLoop;
+
   private:
     using InstructionProc = void (SharpSM83::*)();
 
+    // 256 base opcodes followed by the 256 CB-prefixed opcodes
+    static constexpr size_t DispatchSize = 512;
+
+    using DispatchTable = std::array<InstructionProc, DispatchSize>;
+
+    // Base opcodes whose operands come from a BlockCache entry instead of the bus
+    using PredecodedDispatchTable = std::array<InstructionProc, 256>;
+
+    struct State {
+      Registers regs;
+      bool halted;
+      bool ime;
+      bool enablingIME;
+      uint8_t ie;
+      uint8_t intFlags;
+    };
+
   private:
+    void FetchInstruction();
+
+    bool FetchCachedInstruction();
+
+    template<bool predecoded>
+    uint8_t FetchOperand(uint8_t offset);
+
+    template<AddressMode mode, Register reg1, Register reg2, bool predecoded>
     void FetchData();
 
-    void FetchInstruction();
+    template<uint16_t index, bool predecoded>
+    void Dispatch();
+
+    template<bool predecoded, size_t... index>
+    static constexpr std::array<InstructionProc, sizeof...(index)> MakeDispatchTable(std::index_sequence<index...>);
+
+    void FinishStep();
+
+    template<uint8_t opcode>
+    static int32_t ExecuteCompiled(SharpSM83 *cpu, uint32_t operand, uint32_t pending);
+
+    template<size_t... index>
+    static constexpr Jit::HandlerTable MakeHandlerTable(std::index_sequence<index...>);
+
+    // M-cycles native code can run before it has to go back to the handlers
+    uint32_t NativeBudget() const;
+
+    bool ContinueBlock(uint16_t next) const;
+
+    void InterpretBlock(const BlockCache::Block &block);
 
-    void Execute();
+    void RunNative(Jit::CompiledBlock code);
+
+    // Steps through the instructions of the block with the plain interpreter
+    void StepBlock(const BlockCache::Block &block);
+
+    void RunLockstep(const BlockCache::Block &block, Jit::CompiledBlock code);
+
+    State CaptureState() const;
+
+    void RestoreState(const State &state);
+
+    static bool SameState(const State &a, const State &b);
 
     void SetFlags(int8_t z, int8_t n, int8_t h, int8_t c);
 
-    Register DecodeRegister(uint8_t reg);
+    static constexpr bool Is16Bit(Register t) {
+      return static_cast<uint8_t>(t) > static_cast<uint8_t>(Register::AF);
+    }
+
+    template<Register t>
+    uint16_t Reg();
+
+    template<Register t>
+    void Reg(uint16_t value);
+
+    template<Register t>
+    uint8_t Reg8();
 
-    bool Is16Bit(const Register &t);
+    template<Register t>
+    void Reg8(uint8_t value);
 
+    template<Condition cond>
     bool CheckCondition();
 
+    template<Condition cond>
     void GotoAddress(uint16_t addr, bool pushPC);
 
-    InstructionProc GetProcessor(Instruction type);
-
     uint16_t reverse(uint16_t n);
 
     void Cycle(uint8_t cycles);
@@ -115,6 +267,9 @@ namespace hijo {
 
     void ProcCB();
 
+    template<uint8_t op>
+    void ProcCB();
+
     void ProcRLCA();
 
     void ProcRRCA();
@@ -147,36 +302,50 @@ namespace hijo {
 
     void ProcEI();
 
+    template<uint8_t op>
     void ProcLD();
 
+    template<uint8_t op>
     void ProcLDH();
 
+    template<uint8_t op>
     void ProcJP();
 
+    template<uint8_t op>
     void ProcJR();
 
+    template<uint8_t op>
     void ProcCALL();
 
+    template<uint8_t op>
     void ProcRST();
 
+    template<uint8_t op>
     void ProcRET();
 
     void ProcRETI();
 
+    template<uint8_t op>
     void ProcPOP();
 
+    template<uint8_t op>
     void ProcPUSH();
 
+    template<uint8_t op>
     void ProcINC();
 
+    template<uint8_t op>
     void ProcDEC();
 
+    template<uint8_t op>
     void ProcSUB();
 
+    template<uint8_t op>
     void ProcSBC();
 
     void ProcADC();
 
+    template<uint8_t op>
     void ProcADD();
 
     uint8_t CPU_FLAG_Z() {
@@ -201,10 +370,8 @@ namespace hijo {
 
     uint16_t m_FetchedData;
     uint16_t m_MemoryDestination;
-    bool DestinationIsMemory;
     uint8_t m_CurrentOpcode;
     uint8_t m_CurrentCycles;
-    Instructions::Opcode *m_CurrentInstruction;
 
     std::vector<DisassemblyLine> m_Disassembly;
 
@@ -216,54 +383,27 @@ namespace hijo {
     uint8_t m_IE;
     uint8_t m_IF;
 
-    std::vector<Register> m_RegisterTypes{
-        Register::B,
-        Register::C,
-        Register::D,
-        Register::E,
-        Register::H,
-        Register::L,
-        Register::HL,
-        Register::A
-    };
+    BlockCache m_BlockCache;
+    bool m_UseBlockCache = false;
+    const BlockCache::Block *m_Block = nullptr;
+    size_t m_BlockIndex = 0;
+    uint32_t m_BlockGeneration = 0;
+    uint16_t m_Operand = 0;
 
-    std::unordered_map<Instruction, InstructionProc> m_Processors{
-        {Instruction::NONE, &SharpSM83::ProcNone},
-        {Instruction::NOP,  &SharpSM83::ProcNOP},
-        {Instruction::LD,   &SharpSM83::ProcLD},
-        {Instruction::LDH,  &SharpSM83::ProcLDH},
-        {Instruction::JP,   &SharpSM83::ProcJP},
-        {Instruction::DI,   &SharpSM83::ProcDI},
-        {Instruction::POP,  &SharpSM83::ProcPOP},
-        {Instruction::PUSH, &SharpSM83::ProcPUSH},
-        {Instruction::JR,   &SharpSM83::ProcJR},
-        {Instruction::CALL, &SharpSM83::ProcCALL},
-        {Instruction::RET,  &SharpSM83::ProcRET},
-        {Instruction::RST,  &SharpSM83::ProcRST},
-        {Instruction::DEC,  &SharpSM83::ProcDEC},
-        {Instruction::INC,  &SharpSM83::ProcINC},
-        {Instruction::ADD,  &SharpSM83::ProcADD},
-        {Instruction::ADC,  &SharpSM83::ProcADC},
-        {Instruction::SUB,  &SharpSM83::ProcSUB},
-        {Instruction::SBC,  &SharpSM83::ProcSBC},
-        {Instruction::AND,  &SharpSM83::ProcAND},
-        {Instruction::XOR,  &SharpSM83::ProcXOR},
-        {Instruction::OR,   &SharpSM83::ProcOR},
-        {Instruction::CP,   &SharpSM83::ProcCP},
-        {Instruction::CB,   &SharpSM83::ProcCB},
-        {Instruction::RRCA, &SharpSM83::ProcRRCA},
-        {Instruction::RLCA, &SharpSM83::ProcRLCA},
-        {Instruction::RRA,  &SharpSM83::ProcRRA},
-        {Instruction::RLA,  &SharpSM83::ProcRLA},
-        {Instruction::STOP, &SharpSM83::ProcSTOP},
-        {Instruction::HALT, &SharpSM83::ProcHALT},
-        {Instruction::DAA,  &SharpSM83::ProcDAA},
-        {Instruction::CPL,  &SharpSM83::ProcCPL},
-        {Instruction::SCF,  &SharpSM83::ProcSCF},
-        {Instruction::CCF,  &SharpSM83::ProcCCF},
-        {Instruction::EI,   &SharpSM83::ProcEI},
-        {Instruction::RETI, &SharpSM83::ProcRETI}
-    };
+    Jit m_Jit;
+    bool m_UseJit = false;
+    bool m_JitLockstep = false;
+    uint32_t m_JitGeneration = 0;
+
+    HaltStats m_HaltStats;
+    uint64_t m_Instructions = 0;
+
+    IdleLoop m_IdleLoop;
+    bool m_UseIdleLoops = false;
+
+    static const DispatchTable m_Dispatch;
+    static const PredecodedDispatchTable m_PredecodedDispatch;
+    static const Jit::HandlerTable m_CompiledHandlers;
   };
 
 } // hijo
@@ -8,51 +8,92 @@ namespace hijo {
     Reset();
   }
 
-  void Timer::Tick() {
-    uint16_t prev = div;
-    div++;
+  void Timer::CatchUp(uint64_t target) {
+    if (target <= m_Timestamp)
+      return;
+
+    uint64_t start = div;
+    uint64_t end = start + (target - m_Timestamp);
 
-    bool update = false;
+    div = static_cast<uint16_t>(end);
+    m_Timestamp = target;
 
     if ((tac & 0x4) == 0)
       return;
 
-    switch (tac & 0x3) {
-      case 0:
-        update = (prev & (1 << 9)) && (!(div & (1 << 9)));
-        break;
+    // The selected bit falls every time DIV crosses a multiple of the period
+    uint8_t shift = TimaShift();
 
-      case 1:
-        update = (prev & (1 << 3)) && (!(div & (1 << 3)));
-        break;
-
-      case 2:
-        update = (prev & (1 << 5)) && (!(div & (1 << 5)));
-        break;
+    IncrementTima((end >> shift) - (start >> shift));
+  }
 
-      case 3:
-        update = (prev & (1 << 7)) && (!(div & (1 << 7)));
-        break;
+  uint64_t Timer::NextOverflow() {
+    if ((tac & 0x4) == 0) {
+      return Scheduler::Never;
     }
 
-    if (update && tac & (1 << 2)) {
-      tima++;
+    uint32_t period = 1u << TimaShift();
+    uint32_t firstEdge = period - (div & (period - 1));
+    uint32_t increments = tima == 0xFF ? 0x100 : 0xFF - tima;
 
-      if (tima == 0xFF) {
-        tima = tma;
+    return m_Timestamp + firstEdge + (increments - 1) * period;
+  }
 
-        auto &bus = Gameboy::Get();
-        Interrupts::RequestInterrupt(bus.m_Cpu, Interrupts::Interrupt::Timer);
+  uint64_t Timer::NextChange(uint16_t address) {
+    switch (address) {
+      case 0xFF04:
+        return m_Timestamp + 0x100 - (div & 0xFF);
+
+      case 0xFF05: {
+        if ((tac & 0x4) == 0) {
+          return Scheduler::Never;
+        }
+
+        uint32_t period = 1u << TimaShift();
+        return m_Timestamp + period - (div & (period - 1));
       }
+
+      default:
+        return Scheduler::Never;
     }
   }
 
+  uint8_t Timer::TimaShift() const {
+    static constexpr uint8_t shifts[] = {10, 4, 6, 8};
+
+    return shifts[tac & 0x3];
+  }
+
+  void Timer::IncrementTima(uint64_t count) {
+    // TIMA reloads from TMA as soon as it reaches 0xFF
+    uint32_t untilReload = tima == 0xFF ? 0x100 : 0xFF - tima;
+
+    if (count < untilReload) {
+      tima = static_cast<uint8_t>(tima + count);
+      return;
+    }
+
+    count -= untilReload;
+
+    uint32_t reloadPeriod = tma == 0xFF ? 0x100 : 0xFF - tma;
+    tima = static_cast<uint8_t>(tma + count % reloadPeriod);
+
+    auto &bus = Gameboy::Get();
+    Interrupts::RequestInterrupt(bus.m_Cpu, Interrupts::Interrupt::Timer);
+  }
+
   void Timer::Reset() {
     div = 0;
     tima = 0;
+    tma = 0;
+    tac = 0;
+    timaWritten = false;
+    m_Timestamp = 0;
   }
 
   void Timer::Write(uint16_t address, uint8_t value) {
+    CatchUp(Gameboy::Get().m_Scheduler.Now());
+
     switch (address) {
       case 0xFF04:
         div = 0;
@@ -73,6 +114,8 @@ namespace hijo {
   }
 
   uint8_t Timer::Read(uint16_t address) {
+    CatchUp(Gameboy::Get().m_Scheduler.Now());
+
     switch (address) {
       case 0xFF04:
         return div >> 8;
@@ -92,4 +135,4 @@ namespace hijo {
       }
     }
   }
-} // hijo
\ No newline at end of file
+} // hijo
@@ -4,11 +4,22 @@
 
 namespace hijo {
 
+  // DIV and TIMA are only brought up to date when they're read or written,
+  // or when the scheduler reaches the next TIMA overflow. The registers hold
+  // their values as of m_Timestamp.
   class Timer {
   public:
     Timer();
 
-    void Tick();
+    // Advances DIV and TIMA to the given bus timestamp
+    void CatchUp(uint64_t target);
+
+    // Bus timestamp of the next TIMA overflow, Scheduler::Never while stopped
+    uint64_t NextOverflow();
+
+    // Earliest bus timestamp at which reading the register can return a
+    // different value, Scheduler::Never if only writes change it
+    uint64_t NextChange(uint16_t address);
 
     void Reset();
 
@@ -16,6 +27,13 @@ namespace hijo {
 
     uint8_t Read(uint16_t address);
 
+  private:
+    // TIMA counts falling edges of DIV bit 9, 3, 5 or 7, i.e. once every
+    // 1 << TimaShift() T-cycles
+    uint8_t TimaShift() const;
+
+    void IncrementTima(uint64_t count);
+
   public:
     uint16_t div;
     uint8_t tima;
@@ -25,7 +43,9 @@ namespace hijo {
     uint32_t totalClockTicks;
     bool timaWritten;
     bool lastTickTime;
+
+  private:
+    uint64_t m_Timestamp = 0;
   };
 
 } // hijo
-
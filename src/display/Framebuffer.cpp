@@ -0,0 +1,46 @@
+#include "Framebuffer.h"
+
+#include <algorithm>
+
+#include "Kernels.h"
+
+namespace hijo {
+
+  void Framebuffer::Fill(uint8_t shade) {
+    std::fill(m_Shades.begin(), m_Shades.end(), shade);
+  }
+
+  void Framebuffer::SetPalette(const Pixel *colors) {
+    std::copy_n(colors, 4, m_Palette);
+  }
+
+  void Framebuffer::ToRGBA(Pixel *out) const {
+    Kernels::ResolvePalette(m_Shades.data(), m_Palette, out, Size);
+  }
+
+  void Framebuffer::ToRGB565(uint16_t *out) const {
+    uint16_t colors[4];
+
+    for (size_t i = 0; i < 4; i++) {
+      const auto &color = m_Palette[i];
+
+      colors[i] = static_cast<uint16_t>(((color.r >> 3) << 11) | ((color.g >> 2) << 5) | (color.b >> 3));
+    }
+
+    Kernels::ResolveRGB565(m_Shades.data(), colors, 4, out, Size);
+  }
+
+  void Framebuffer::ToGrayscale(uint8_t *out) const {
+    uint8_t levels[4];
+
+    // Rec. 601 luma in 8-bit fixed point
+    for (size_t i = 0; i < 4; i++) {
+      const auto &color = m_Palette[i];
+
+      levels[i] = static_cast<uint8_t>((color.r * 77 + color.g * 150 + color.b * 29) >> 8);
+    }
+
+    Kernels::MapIndices(m_Shades.data(), levels, 4, out, Size);
+  }
+
+} // hijo
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace hijo {
+
+  // RGBA8, laid out like raylib's Color so a front-end can upload a
+  // converted frame as is
+  struct Pixel {
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+    uint8_t a;
+  };
+
+  namespace Pixels {
+    constexpr Pixel White{0xFF, 0xFF, 0xFF, 0xFF};
+    constexpr Pixel LightGray{0xAA, 0xAA, 0xAA, 0xFF};
+    constexpr Pixel DarkGray{0x55, 0x55, 0x55, 0xFF};
+    constexpr Pixel Black{0x00, 0x00, 0x00, 0xFF};
+  }
+
+  // The LCD as the PPU draws it: one shade (0-3, BGP/OBP already applied)
+  // per pixel, and the colors those shades stand for this frame. Hashing,
+  // snapshots and bots can use the shades directly; anything that shows
+  // the frame converts it when it needs to.
+  class Framebuffer {
+  public:
+    static constexpr size_t Width = 160;
+    static constexpr size_t Height = 144;
+    static constexpr size_t Size = Width * Height;
+
+  public:
+    Framebuffer() : m_Shades(Size, 0), m_Palette{Pixels::White, Pixels::LightGray, Pixels::DarkGray, Pixels::Black} {}
+
+    uint8_t *Line(size_t y) {
+      return &m_Shades[y * Width];
+    }
+
+    const uint8_t *Data() const {
+      return m_Shades.data();
+    }
+
+    void Fill(uint8_t shade);
+
+    const Pixel *Palette() const {
+      return m_Palette;
+    }
+
+    void SetPalette(const Pixel *colors);
+
+    // Each writes Size pixels
+    void ToRGBA(Pixel *out) const;
+
+    void ToRGB565(uint16_t *out) const;
+
+    void ToGrayscale(uint8_t *out) const;
+
+  private:
+    std::vector<uint8_t> m_Shades;
+    Pixel m_Palette[4];
+  };
+
+} // hijo
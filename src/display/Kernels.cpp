@@ -0,0 +1,243 @@
+#include "Kernels.h"
+
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define HIJO_KERNELS_AVX2
+#define HIJO_KERNELS_SSE2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define HIJO_KERNELS_SSE2
+#endif
+
+namespace hijo {
+
+  namespace {
+    // Each bit of a byte moved to its own byte, most significant bit first
+    struct SpreadTable {
+      uint8_t bytes[256][8];
+
+      constexpr SpreadTable() : bytes() {
+        for (int value = 0; value < 256; value++) {
+          for (int x = 0; x < 8; x++) {
+            bytes[value][x] = (value >> (7 - x)) & 1;
+          }
+        }
+      }
+    };
+
+    constexpr SpreadTable Spread{};
+
+    static_assert(sizeof(Pixel) == sizeof(uint32_t), "Pixels are looked up as 32-bit words");
+
+#ifdef HIJO_KERNELS_AVX2
+    // Bytes 0-7 test bits 7-0
+    constexpr long long RowBits = 0x0102040810204080;
+
+    inline long long Broadcast(uint8_t value) {
+      return static_cast<long long>(value * 0x0101010101010101ull);
+    }
+#endif
+  }
+
+  namespace Kernels {
+    namespace Scalar {
+      void DecodeTile(const uint8_t *data, uint8_t *out) {
+        for (auto row = 0; row < 8; row++) {
+          Kernels::DecodeRow(data[row * 2], data[row * 2 + 1], out + row * 8);
+        }
+      }
+
+      void MergeSprites(const uint8_t *background, bool showBackground, const uint8_t *front,
+                        const uint8_t *any, uint8_t *out, size_t count) {
+        for (size_t i = 0; i < count; i++) {
+          uint8_t sprite = background[i] ? front[i] : any[i];
+
+          if (sprite) {
+            out[i] = sprite;
+          } else {
+            out[i] = showBackground ? background[i] : 0;
+          }
+        }
+      }
+
+      void MapIndices(const uint8_t *pixels, const uint8_t *table, uint8_t *out, size_t count) {
+        for (size_t i = 0; i < count; i++) {
+          out[i] = table[pixels[i]];
+        }
+      }
+
+      void ResolvePalette(const uint8_t *pixels, const Pixel *palette, Pixel *out, size_t count) {
+        for (size_t i = 0; i < count; i++) {
+          out[i] = palette[pixels[i]];
+        }
+      }
+
+      void ResolveRGB565(const uint8_t *pixels, const uint16_t *palette, uint16_t *out, size_t count) {
+        for (size_t i = 0; i < count; i++) {
+          out[i] = palette[pixels[i]];
+        }
+      }
+    }
+
+    const char *InstructionSet() {
+#if defined(HIJO_KERNELS_AVX2)
+      return "avx2";
+#elif defined(HIJO_KERNELS_SSE2)
+      return "sse2";
+#else
+      return "scalar";
+#endif
+    }
+
+    void DecodeRow(uint8_t low, uint8_t high, uint8_t *out) {
+      uint64_t lowBits;
+      uint64_t highBits;
+
+      std::memcpy(&lowBits, Spread.bytes[low], 8);
+      std::memcpy(&highBits, Spread.bytes[high], 8);
+
+      // Every byte is 0 or 1, so the shift can't carry into the next one
+      uint64_t row = lowBits | (highBits << 1);
+
+      std::memcpy(out, &row, 8);
+    }
+
+    void DecodeTile(const uint8_t *data, uint8_t *out) {
+#if defined(HIJO_KERNELS_AVX2)
+      const __m256i bits = _mm256_set1_epi64x(RowBits);
+      const __m256i one = _mm256_set1_epi8(1);
+      const __m256i two = _mm256_set1_epi8(2);
+
+      for (auto row = 0; row < 8; row += 4) {
+        const uint8_t *src = data + row * 2;
+
+        __m256i low = _mm256_set_epi64x(Broadcast(src[6]), Broadcast(src[4]), Broadcast(src[2]), Broadcast(src[0]));
+        __m256i high = _mm256_set_epi64x(Broadcast(src[7]), Broadcast(src[5]), Broadcast(src[3]), Broadcast(src[1]));
+
+        low = _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_and_si256(low, bits), bits), one);
+        high = _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_and_si256(high, bits), bits), two);
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + row * 8), _mm256_or_si256(low, high));
+      }
+#else
+      // Rows are only 8 bytes, the spread table keeps up with SSE2 there
+      Scalar::DecodeTile(data, out);
+#endif
+    }
+
+    void MergeSprites(const uint8_t *background, bool showBackground, const uint8_t *front,
+                      const uint8_t *any, uint8_t *out, size_t count) {
+      size_t i = 0;
+
+#if defined(HIJO_KERNELS_AVX2)
+      const __m256i zero = _mm256_setzero_si256();
+      const __m256i shown = showBackground ? _mm256_set1_epi8(-1) : zero;
+
+      for (; i + 32 <= count; i += 32) {
+        __m256i bg = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(background + i));
+        __m256i inFront = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(front + i));
+        __m256i anyPriority = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(any + i));
+
+        __m256i sprite = _mm256_blendv_epi8(inFront, anyPriority, _mm256_cmpeq_epi8(bg, zero));
+        __m256i visible = _mm256_and_si256(bg, shown);
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i),
+                            _mm256_blendv_epi8(sprite, visible, _mm256_cmpeq_epi8(sprite, zero)));
+      }
+#elif defined(HIJO_KERNELS_SSE2)
+      const __m128i zero = _mm_setzero_si128();
+      const __m128i shown = showBackground ? _mm_set1_epi8(-1) : zero;
+
+      for (; i + 16 <= count; i += 16) {
+        __m128i bg = _mm_loadu_si128(reinterpret_cast<const __m128i *>(background + i));
+        __m128i inFront = _mm_loadu_si128(reinterpret_cast<const __m128i *>(front + i));
+        __m128i anyPriority = _mm_loadu_si128(reinterpret_cast<const __m128i *>(any + i));
+
+        __m128i transparent = _mm_cmpeq_epi8(bg, zero);
+        __m128i sprite = _mm_or_si128(_mm_and_si128(transparent, anyPriority),
+                                      _mm_andnot_si128(transparent, inFront));
+        __m128i visible = _mm_and_si128(bg, shown);
+        __m128i empty = _mm_cmpeq_epi8(sprite, zero);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i),
+                         _mm_or_si128(_mm_and_si128(empty, visible), _mm_andnot_si128(empty, sprite)));
+      }
+#endif
+
+      Scalar::MergeSprites(background + i, showBackground, front + i, any + i, out + i, count - i);
+    }
+
+    void MapIndices(const uint8_t *pixels, const uint8_t *table, size_t entries, uint8_t *out, size_t count) {
+      size_t i = 0;
+
+#if defined(HIJO_KERNELS_AVX2)
+      alignas(16) uint8_t bytes[16]{};
+
+      std::memcpy(bytes, table, entries);
+
+      const __m256i lookup = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i *>(bytes)));
+
+      for (; i + 32 <= count; i += 32) {
+        __m256i indices = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pixels + i));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), _mm256_shuffle_epi8(lookup, indices));
+      }
+#else
+      (void) entries;
+#endif
+
+      Scalar::MapIndices(pixels + i, table, out + i, count - i);
+    }
+
+    void ResolvePalette(const uint8_t *pixels, const Pixel *palette, Pixel *out, size_t count) {
+      size_t i = 0;
+
+#if defined(HIJO_KERNELS_AVX2)
+      const int *table = reinterpret_cast<const int *>(palette);
+
+      for (; i + 8 <= count; i += 8) {
+        __m128i indices = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(pixels + i));
+        __m256i colors = _mm256_i32gather_epi32(table, _mm256_cvtepu8_epi32(indices), 4);
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), colors);
+      }
+#endif
+
+      Scalar::ResolvePalette(pixels + i, palette, out + i, count - i);
+    }
+
+    void ResolveRGB565(const uint8_t *pixels, const uint16_t *palette, size_t entries, uint16_t *out, size_t count) {
+      size_t i = 0;
+
+#if defined(HIJO_KERNELS_AVX2)
+      // Low and high bytes are looked up separately and interleaved again
+      alignas(16) uint8_t low[16]{};
+      alignas(16) uint8_t high[16]{};
+
+      for (size_t entry = 0; entry < entries; entry++) {
+        low[entry] = palette[entry] & 0xFF;
+        high[entry] = palette[entry] >> 8;
+      }
+
+      const __m128i lowLookup = _mm_load_si128(reinterpret_cast<const __m128i *>(low));
+      const __m128i highLookup = _mm_load_si128(reinterpret_cast<const __m128i *>(high));
+
+      for (; i + 16 <= count; i += 16) {
+        __m128i indices = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pixels + i));
+        __m128i lowBytes = _mm_shuffle_epi8(lowLookup, indices);
+        __m128i highBytes = _mm_shuffle_epi8(highLookup, indices);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_unpacklo_epi8(lowBytes, highBytes));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i + 8), _mm_unpackhi_epi8(lowBytes, highBytes));
+      }
+#else
+      (void) entries;
+#endif
+
+      Scalar::ResolveRGB565(pixels + i, palette, out + i, count - i);
+    }
+  }
+
+} // hijo
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Framebuffer.h"
+
+namespace hijo {
+
+  // Line-at-a-time pixel work for the renderers and the debug viewers.
+  // Built for AVX2 when the compiler targets it (HIJO_AVX2), for SSE2 on
+  // x86-64, and as plain loops everywhere else.
+  //
+  // Composited pixels are palette * 4 + color: palette 0 is BGP, 1 is OBP0
+  // and 2 is OBP1, the same order as PPU::FifoPalette.
+  namespace Kernels {
+    // Instruction set the kernels below were built for
+    const char *InstructionSet();
+
+    // Splits the two bitplanes of a tile row into eight color indices,
+    // left to right
+    void DecodeRow(uint8_t low, uint8_t high, uint8_t *out);
+
+    // Decodes the 16 bytes of a tile into 64 color indices
+    void DecodeTile(const uint8_t *data, uint8_t *out);
+
+    // Puts the sprite line over the background. front holds the first
+    // opaque sprite pixel that isn't behind the background, any the first
+    // opaque one whatever its priority, 0 meaning none. The background
+    // index decides which applies; it's shown (or color 0 when showBackground
+    // is off) where neither does.
+    void MergeSprites(const uint8_t *background, bool showBackground, const uint8_t *front,
+                      const uint8_t *any, uint8_t *out, size_t count);
+
+    // Replaces each pixel with its entry in a byte table of up to 16
+    // entries, e.g. composited pixels to shades or shades to gray levels
+    void MapIndices(const uint8_t *pixels, const uint8_t *table, size_t entries, uint8_t *out, size_t count);
+
+    // Looks pixels up in a table of colors
+    void ResolvePalette(const uint8_t *pixels, const Pixel *palette, Pixel *out, size_t count);
+
+    // Same as ResolvePalette for a table of up to 16 RGB565 colors
+    void ResolveRGB565(const uint8_t *pixels, const uint16_t *palette, size_t entries, uint16_t *out, size_t count);
+
+    // Plain versions of the above, for comparison
+    namespace Scalar {
+      void DecodeTile(const uint8_t *data, uint8_t *out);
+
+      void MergeSprites(const uint8_t *background, bool showBackground, const uint8_t *front,
+                        const uint8_t *any, uint8_t *out, size_t count);
+
+      void MapIndices(const uint8_t *pixels, const uint8_t *table, uint8_t *out, size_t count);
+
+      void ResolvePalette(const uint8_t *pixels, const Pixel *palette, Pixel *out, size_t count);
+
+      void ResolveRGB565(const uint8_t *pixels, const uint16_t *palette, uint16_t *out, size_t count);
+    }
+  }
+
+} // hijo
@@ -88,6 +88,12 @@ namespace hijo {
   }
 
   void LCD::PaletteUpdate(uint8_t data, uint8_t palette) {
+    if (palette < 3) {
+      for (auto i = 0; i < 4; i++) {
+        regs.shades[palette * 4 + i] = (data >> (i * 2)) & 0x3;
+      }
+    }
+
     switch (palette) {
       case 0:
         regs.bgColors[0] = m_DefaultColors[data & 0x3];
@@ -134,5 +140,9 @@ namespace hijo {
     regs.bgColors = m_DefaultColors;
     regs.sp1Colors = m_DefaultColors;
     regs.sp2Colors = m_DefaultColors;
+
+    for (auto i = 0; i < 12; i++) {
+      regs.shades[i] = i % 4;
+    }
   }
 } // hijo
\ No newline at end of file
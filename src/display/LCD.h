@@ -1,6 +1,6 @@
 #pragma once
 
-#include <raylib.h>
+#include "Framebuffer.h"
 #include <cstdint>
 #include <vector>
 
@@ -21,10 +21,14 @@ namespace hijo {
       uint8_t WINY;
       uint8_t WINX;
 
+      // Shade of each composited pixel (palette * 4 + color), BGP then OBP0
+      // and OBP1
+      uint8_t shades[12];
+
       // Colors
-      std::vector<Color> bgColors;
-      std::vector<Color> sp1Colors;
-      std::vector<Color> sp2Colors;
+      std::vector<Pixel> bgColors;
+      std::vector<Pixel> sp1Colors;
+      std::vector<Pixel> sp2Colors;
     };
 
     enum class Mode {
@@ -58,6 +62,11 @@ namespace hijo {
 
     Registers &Regs();
 
+    // Colors of the four shades
+    const std::vector<Pixel> &ShadeColors() const {
+      return m_DefaultColors;
+    }
+
   public:
     bool LCDC_BGWEnabled();
 
@@ -101,11 +110,11 @@ namespace hijo {
   private:
     Registers regs;
 
-    std::vector<Color> m_DefaultColors{
-        WHITE,
-        {0xAA, 0xAA, 0xAA, 0xFF},
-        {0x55, 0x55, 0x55, 0xFF},
-        BLACK
+    std::vector<Pixel> m_DefaultColors{
+        Pixels::White,
+        Pixels::LightGray,
+        Pixels::DarkGray,
+        Pixels::Black
     };
   };
 } // hijo
@@ -1,5 +1,10 @@
 
 #include "PPU.h"
+
+#include <algorithm>
+#include <bit>
+
+#include "Kernels.h"
 #include "LCD.h"
 #include "system/Gameboy.h"
 #include "cpu/Interrupts.h"
@@ -17,30 +22,39 @@ namespace hijo {
 
     currentFrame = 0;
     lineTicks = 0;
-    videoBuffer.clear();
-    videoBuffer.reserve(m_YRes * m_XRes);
+    m_Timestamp = 0;
 
     fifo.lineX = 0;
     fifo.pushedX = 0;
     fifo.fetchX = 0;
     fifo.pixelFifo.size = 0;
-    fifo.pixelFifo.head = nullptr;
-    fifo.pixelFifo.tail = nullptr;
+    fifo.pixelFifo.head = 0;
     fifo.state = FetchState::Tile;
 
     lineSprites = nullptr;
     fetchedEntryCount = 0;
     windowLine = 0;
 
+    m_Scanline = m_PendingScanline;
+    m_TransferEnd = 0;
+
+    for (uint8_t fineX = 0; fineX < 8; fineX++) {
+      m_TransferDots[fineX] = TransferDots(fineX);
+    }
+
     lcd.Reset();
     lcd.LCDS_SetMode(LCD::Mode::OAM);
 
     memset(m_VideoRam, 0, 1024 * 8);
+    m_Tiles.InvalidateAll();
+    m_TilemapVersion++;
     memset(m_OAMRam, 0, sizeof(m_OAMRam));
+    m_IndexedHeight = lcd.LCDC_ObjHeight();
+    RebuildSpriteIndex();
 
-    for (auto n = 0; n < m_YRes * m_XRes; n++) {
-      videoBuffer.push_back({0, 0, 0, 0xFF});
-    }
+    // Black until the first frame is drawn
+    videoBuffer.Fill(3);
+    videoBuffer.SetPalette(lcd.ShadeColors().data());
   }
 
   void PPU::Tick() {
@@ -64,6 +78,88 @@ namespace hijo {
     }
   }
 
+  void PPU::Advance(uint64_t dots) {
+    while (dots) {
+      uint32_t idle = IdleDots();
+
+      if (idle) {
+        uint32_t skip = dots < idle ? static_cast<uint32_t>(dots) : idle;
+
+        lineTicks += skip;
+        dots -= skip;
+        continue;
+      }
+
+      Tick();
+      dots--;
+    }
+  }
+
+  void PPU::CatchUp(uint64_t target) {
+    if (m_Timestamp < target) {
+      Advance(target - m_Timestamp);
+      m_Timestamp = target;
+    }
+  }
+
+  uint64_t PPU::NextEvent() {
+    return m_Timestamp + NextEventDelay();
+  }
+
+  uint32_t PPU::NextEventDelay() {
+    auto &lcd = LCD::Get();
+    int32_t delay = 1;
+
+    // Lower bounds only: XFER pushes at most one pixel per dot, so HBlank
+    // can't start before every remaining pixel has had its dot.
+    switch (lcd.LCDS_Mode()) {
+      case LCD::Mode::OAM:
+        delay = static_cast<int32_t>(m_OAMTicks) - static_cast<int32_t>(lineTicks) + m_XRes;
+        break;
+      case LCD::Mode::XFER:
+        if (m_Scanline && lineTicks > m_OAMTicks) {
+          delay = static_cast<int32_t>(m_TransferEnd) - static_cast<int32_t>(lineTicks);
+        } else {
+          delay = static_cast<int32_t>(m_XRes) - fifo.pushedX;
+        }
+        break;
+      case LCD::Mode::HBlank:
+      case LCD::Mode::VBlank:
+        delay = static_cast<int32_t>(m_TicksPerLine) - static_cast<int32_t>(lineTicks);
+        break;
+    }
+
+    return delay > 1 ? delay : 1;
+  }
+
+  uint32_t PPU::IdleDots() {
+    auto &lcd = LCD::Get();
+    uint32_t last = lineTicks;
+
+    // Tick bumps lineTicks first, so these are the last counts at which the
+    // next dot still does nothing
+    switch (lcd.LCDS_Mode()) {
+      case LCD::Mode::OAM:
+        // Sprites are picked on dot 1, mode 3 starts on dot m_OAMTicks
+        last = m_OAMTicks - 1;
+        if (lineTicks < 1)
+          return 0;
+        break;
+      case LCD::Mode::XFER:
+        // The line is drawn on the first dot of mode 3
+        if (!m_Scanline || lineTicks <= m_OAMTicks)
+          return 0;
+        last = m_TransferEnd - 1;
+        break;
+      case LCD::Mode::HBlank:
+      case LCD::Mode::VBlank:
+        last = m_TicksPerLine - 1;
+        break;
+    }
+
+    return lineTicks < last ? last - lineTicks : 0;
+  }
+
   void PPU::OAMWrite(uint16_t addr, uint8_t data) {
     if (addr >= 0xFE00)
       addr -= 0xFE00;
@@ -73,11 +169,15 @@ namespace hijo {
 
     switch (field) {
       case 0:
+        IndexSprite(index, false);
         m_OAMRam[index].y = data;
+        IndexSprite(index, true);
         break;
 
       case 1:
+        IndexSprite(index, false);
         m_OAMRam[index].x = data;
+        IndexSprite(index, true);
         break;
 
       case 2:
@@ -90,6 +190,46 @@ namespace hijo {
     }
   }
 
+  void PPU::OAMCopy(uint8_t offset, const uint8_t *data, size_t count) {
+    size_t first = offset / 4;
+    size_t last = (offset + count - 1) / 4;
+
+    for (auto i = first; i <= last; i++) {
+      IndexSprite(i, false);
+    }
+
+    memcpy(reinterpret_cast<uint8_t *>(m_OAMRam) + offset, data, count);
+
+    for (auto i = first; i <= last; i++) {
+      IndexSprite(i, true);
+    }
+  }
+
+  uint64_t PPU::NextOAMScan() {
+    auto &lcd = LCD::Get();
+    auto &lcdRegs = lcd.Regs();
+
+    // The scan is the first dot of a visible line
+    if (lcd.LCDS_Mode() == LCD::Mode::OAM && lineTicks == 0) {
+      return m_Timestamp;
+    }
+
+    if (lineTicks >= m_TicksPerLine) {
+      return m_Timestamp;
+    }
+
+    uint64_t lineEnd = m_Timestamp + (m_TicksPerLine - lineTicks);
+
+    if (lcdRegs.LY + 1 < m_YRes) {
+      return lineEnd;
+    }
+
+    // Past the last visible line, the next scan starts the next frame
+    uint32_t lines = lcdRegs.LY < m_LinesPerFrame ? m_LinesPerFrame - 1 - lcdRegs.LY : 0;
+
+    return lineEnd + static_cast<uint64_t>(lines) * m_TicksPerLine;
+  }
+
   uint8_t PPU::OAMRead(uint16_t addr) {
     if (addr >= 0xFE00)
       addr -= 0xFE00;
@@ -116,6 +256,11 @@ namespace hijo {
 
   void PPU::VRAMWrite(uint16_t addr, uint8_t data) {
     m_VideoRam[addr - 0x8000] = data;
+    m_Tiles.Invalidate(addr - 0x8000);
+
+    if (addr >= 0x9800) {
+      m_TilemapVersion++;
+    }
   }
 
   uint8_t PPU::VRAMRead(uint16_t addr) {
@@ -131,40 +276,41 @@ namespace hijo {
            lcdRegs.WINY >= 0 && lcdRegs.WINY < m_YRes;
   }
 
-  void PPU::PixelFifoPush(Color value) {
-    FifoEntry *next = new FifoEntry();
-    next->next = nullptr;
-    next->value = value;
+  void PPU::PixelFifoPush(FifoEntry value) {
+    auto &pixels = fifo.pixelFifo;
 
-    if (!fifo.pixelFifo.head) {
-      fifo.pixelFifo.head = next;
-      fifo.pixelFifo.tail = next;
-    } else {
-      fifo.pixelFifo.tail->next = next;
-      fifo.pixelFifo.tail = next;
+    if (pixels.size >= Fifo::Capacity) {
+      spdlog::get("console")->warn("Full Pixel Fifo Pushed");
+      return;
     }
 
-    fifo.pixelFifo.size++;
+    pixels.entries[(pixels.head + pixels.size) % Fifo::Capacity] = value;
+    pixels.size++;
   }
 
-  Color PPU::PixelFifoPop() {
-    if (fifo.pixelFifo.size <= 0) {
+  PPU::FifoEntry PPU::PixelFifoPop() {
+    auto &pixels = fifo.pixelFifo;
+
+    if (pixels.size <= 0) {
       spdlog::get("console")->warn("Empty Pixel Fifo Popped");
-      return BLACK;
+      return {};
     }
 
-    FifoEntry *popped = fifo.pixelFifo.head;
-
-    fifo.pixelFifo.head = popped->next;
-    fifo.pixelFifo.size--;
+    FifoEntry value = pixels.entries[pixels.head];
 
-    Color value = popped->value;
-    delete popped;
+    pixels.head = (pixels.head + 1) % Fifo::Capacity;
+    pixels.size--;
 
     return value;
   }
 
-  Color PPU::FetchSpritePixels(uint8_t bit, Color color, uint8_t bgColor) {
+  uint8_t PPU::PixelShade(FifoEntry pixel) {
+    auto &lcdRegs = LCD::Get().Regs();
+
+    return lcdRegs.shades[static_cast<uint8_t>(pixel.palette) * 4 + pixel.color];
+  }
+
+  PPU::FifoEntry PPU::FetchSpritePixels(FifoEntry pixel, uint8_t bgColor) {
     auto &lcd = LCD::Get();
     auto &lcdRegs = lcd.Regs();
 
@@ -179,30 +325,21 @@ namespace hijo {
       if (offset < 0 || offset > 7)
         continue;
 
-      bit = 7 - offset;
-
-      if (OAMEntryXFlip(fetchedEntries[i]))
-        bit = offset;
-
-      uint8_t high = !!(fifo.fetchEntryData[i * 2] & (1 << bit));
-      uint8_t low = !!(fifo.fetchEntryData[(i * 2) + 1] & (1 << bit)) << 1;
+      uint8_t color = m_SpriteRows[i][offset];
 
       bool bgPriority = OAMEntryBackgroundPriority(fetchedEntries[i]);
 
-      if (!(high | low))
+      if (!color)
         continue;
 
       if (!bgPriority || bgColor == 0) {
-        color = OAMEntryPaletteNumber(fetchedEntries[i])
-                ? lcdRegs.sp2Colors[high | low]
-                : lcdRegs.sp1Colors[high | low];
-
-        if (high | low)
-          break;
+        pixel.color = color;
+        pixel.palette = OAMEntryPaletteNumber(fetchedEntries[i]) ? FifoPalette::OBP1 : FifoPalette::OBP0;
+        break;
       }
     }
 
-    return color;
+    return pixel;
   }
 
   bool PPU::PipelineFifoAdd() {
@@ -214,25 +351,36 @@ namespace hijo {
     }
 
     int32_t x = fifo.fetchX - (8 - (lcdRegs.SCRX % 8));
+    bool objects = lcd.LCDC_OBJEnabled();
 
-    for (auto i = 0; i < 8; i++) {
-      int bit = 7 - i;
+    uint8_t row[8];
+    Kernels::DecodeRow(fifo.bgwFetchData[1], fifo.bgwFetchData[2], row);
 
-      uint8_t high = !!(fifo.bgwFetchData[1] & (1 << bit));
-      uint8_t low = !!(fifo.bgwFetchData[2] & (1 << bit)) << 1;
+    if (objects) {
+      for (auto i = 0; i < fetchedEntryCount; i++) {
+        uint8_t *sprite = m_SpriteRows[i];
 
-      auto color = lcdRegs.bgColors[high | low];
+        Kernels::DecodeRow(fifo.fetchEntryData[i * 2], fifo.fetchEntryData[(i * 2) + 1], sprite);
+
+        if (OAMEntryXFlip(fetchedEntries[i])) {
+          std::reverse(sprite, sprite + 8);
+        }
+      }
+    }
+
+    for (auto i = 0; i < 8; i++) {
+      FifoEntry pixel{row[i], FifoPalette::BGW};
 
       if (!lcd.LCDC_BGWEnabled()) {
-        color = lcdRegs.bgColors[0];
+        pixel.color = 0;
       }
 
-      if (lcd.LCDC_OBJEnabled()) {
-        color = FetchSpritePixels(bit, color, high | low);
+      if (objects) {
+        pixel = FetchSpritePixels(pixel, row[i]);
       }
 
       if (x >= 0) {
-        PixelFifoPush(color);
+        PixelFifoPush(pixel);
         fifo.fifoX++;
       }
     }
@@ -261,27 +409,32 @@ namespace hijo {
     }
   }
 
-  void PPU::PipelineLoadSpriteData(uint8_t offset) {
+  uint16_t PPU::SpriteRowOffset(const OAMEntry &entry) {
     auto &lcd = LCD::Get();
     auto &lcdRegs = lcd.Regs();
-    auto &bus = Gameboy::Get();
 
     int32_t curY = lcdRegs.LY;
     uint8_t sprHeight = lcd.LCDC_ObjHeight();
 
-    for (auto i = 0; i < fetchedEntryCount; i++) {
-      uint8_t ty = ((curY + 16) - fetchedEntries[i].y) * 2;
+    uint8_t ty = ((curY + 16) - entry.y) * 2;
+
+    if (OAMEntryYFlip(entry))
+      ty = ((sprHeight * 2) - 2) - ty;
+
+    uint8_t tileIndex = entry.tile;
 
-      if (OAMEntryYFlip(fetchedEntries[i]))
-        ty = ((sprHeight * 2) - 2) - ty;
+    if (sprHeight == 16)
+      tileIndex &= ~(1);
 
-      uint8_t tileIndex = fetchedEntries[i].tile;
+    return (tileIndex * 16) + ty;
+  }
 
-      if (sprHeight == 16)
-        tileIndex &= ~(1);
+  void PPU::PipelineLoadSpriteData(uint8_t offset) {
+    auto &bus = Gameboy::Get();
 
+    for (auto i = 0; i < fetchedEntryCount; i++) {
       fifo.fetchEntryData[(i * 2) + offset] =
-          bus.cpuRead(0x8000 + (tileIndex * 16) + ty + offset);
+          bus.cpuRead(0x8000 + SpriteRowOffset(fetchedEntries[i]) + offset);
     }
   }
 
@@ -368,10 +521,10 @@ namespace hijo {
     auto &lcdRegs = lcd.Regs();
 
     if (fifo.pixelFifo.size > 8) {
-      Color pixData = PixelFifoPop();
+      FifoEntry pixel = PixelFifoPop();
 
       if (fifo.lineX >= (lcdRegs.SCRX % 8)) {
-        videoBuffer[fifo.pushedX + (lcdRegs.LY * m_XRes)] = pixData;
+        videoBuffer.Line(lcdRegs.LY)[fifo.pushedX] = PixelShade(pixel);
 
         fifo.pushedX++;
       }
@@ -395,18 +548,149 @@ namespace hijo {
   }
 
   void PPU::PipelineFifoReset() {
-    while (fifo.pixelFifo.size)
-      PixelFifoPop();
+    fifo.pixelFifo.head = 0;
+    fifo.pixelFifo.size = 0;
+  }
+
+  void PPU::RenderScanline() {
+    auto &lcd = LCD::Get();
+    auto &lcdRegs = lcd.Regs();
+
+    uint8_t fineX = lcdRegs.SCRX % 8;
+    uint8_t mapY = lcdRegs.LY + lcdRegs.SCRY;
+    uint8_t tileRow = mapY % 8;
+    uint16_t tileData = lcd.LCDC_BGWTileDataArea();
+    size_t tileBase = (tileData - 0x8000) / TileCache::TileBytes;
+    uint16_t bgTilemap = lcd.LCDC_BGTilemapArea() + (mapY / 8) * 32;
+    uint16_t winTilemap = lcd.LCDC_WindowTilemapArea() + (windowLine / 8) * 32;
+
+    bool bgw = lcd.LCDC_BGWEnabled();
+    bool objects = lcd.LCDC_OBJEnabled();
+    bool window = bgw && WindowVisible() &&
+                  lcdRegs.LY >= lcdRegs.WINY && lcdRegs.LY < lcdRegs.WINY + m_XRes;
+
+    // The FIFO's pixel stream, fineX pixels longer than the line. Sprite
+    // pixels are (palette << 2) | color: front holds the first one drawn
+    // over any background, any the first one at all.
+    uint8_t background[m_StreamLength];
+    uint8_t front[m_StreamLength]{};
+    uint8_t any[m_StreamLength]{};
+
+    for (uint32_t fetchX = 0; fetchX < static_cast<uint32_t>(m_XRes + fineX); fetchX += 8) {
+      fetchedEntryCount = 0;
+
+      if (bgw) {
+        uint8_t mapX = fetchX + lcdRegs.SCRX;
+
+        fifo.bgwFetchData[0] = m_VideoRam[bgTilemap + (mapX / 8) - 0x8000];
+
+        if (window && fetchX + 7 >= lcdRegs.WINX && fetchX + 7 < static_cast<uint32_t>(lcdRegs.WINX + m_YRes + 14)) {
+          fifo.bgwFetchData[0] = m_VideoRam[winTilemap + (fetchX + 7 - lcdRegs.WINX) / 8 - 0x8000];
+        }
+
+        if (tileData == 0x8800) {
+          fifo.bgwFetchData[0] += 128;
+        }
+      }
+
+      std::copy_n(m_Tiles.Row(tileBase + fifo.bgwFetchData[0], tileRow), 8, background + fetchX);
+
+      if (!objects || !lineSprites) {
+        continue;
+      }
+
+      // Sprites only compete for the pixels of the fetch that picked them
+      fifo.fetchX = fetchX;
+      PipelineLoadSpriteTile();
+
+      for (auto i = 0; i < fetchedEntryCount; i++) {
+        const auto &entry = fetchedEntries[i];
+
+        uint16_t offset = SpriteRowOffset(entry);
+        const uint8_t *sprite = m_Tiles.Row(offset / TileCache::TileBytes, (offset % TileCache::TileBytes) / 2,
+                                            OAMEntryXFlip(entry));
+
+        int32_t spX = (entry.x - 8) + fineX;
+        uint8_t palette = static_cast<uint8_t>(OAMEntryPaletteNumber(entry) ? FifoPalette::OBP1 : FifoPalette::OBP0);
+
+        for (uint32_t x = fetchX; x < fetchX + 8; x++) {
+          int32_t column = static_cast<int32_t>(x) - spX;
+
+          if (column < 0 || column > 7 || !sprite[column])
+            continue;
+
+          uint8_t pixel = (palette << 2) | sprite[column];
 
-    fifo.pixelFifo.head = nullptr;
+          if (!any[x])
+            any[x] = pixel;
+
+          if (!front[x] && !OAMEntryBackgroundPriority(entry))
+            front[x] = pixel;
+        }
+      }
+    }
+
+    uint8_t merged[m_XRes];
+
+    Kernels::MergeSprites(background + fineX, bgw, front + fineX, any + fineX, merged, m_XRes);
+    Kernels::MapIndices(merged, lcdRegs.shades, sizeof(lcdRegs.shades), videoBuffer.Line(lcdRegs.LY), m_XRes);
+
+    fifo.pushedX = m_XRes;
+  }
+
+  uint32_t PPU::TransferDots(uint8_t fineX) const {
+    // Mirrors the cadence of PipelineProcess: the fetcher steps every other
+    // dot and only pushes while 8 or fewer pixels are queued, and one pixel
+    // leaves the FIFO per dot once more than 8 are, the first fineX of
+    // them being thrown away.
+    FetchState state = FetchState::Tile;
+    uint32_t ticks = m_OAMTicks;
+    uint32_t queued = 0;
+    uint32_t popped = 0;
+
+    while (popped < static_cast<uint32_t>(m_XRes + fineX)) {
+      ticks++;
+
+      if (!(ticks & 1)) {
+        switch (state) {
+          case FetchState::Tile:
+            state = FetchState::Data0;
+            break;
+          case FetchState::Data0:
+            state = FetchState::Data1;
+            break;
+          case FetchState::Data1:
+            state = FetchState::Idle;
+            break;
+          case FetchState::Idle:
+            state = FetchState::Push;
+            break;
+          case FetchState::Push:
+            if (queued <= 8) {
+              queued += 8;
+              state = FetchState::Tile;
+            }
+            break;
+        }
+      }
+
+      if (queued > 8) {
+        queued--;
+        popped++;
+      }
+    }
+
+    return ticks - m_OAMTicks;
   }
 
   void PPU::OAMMode() {
     auto &lcd = LCD::Get();
 
-    if (lineTicks >= 80) {
+    if (lineTicks >= m_OAMTicks) {
       lcd.LCDS_SetMode(LCD::Mode::XFER);
 
+      m_Scanline = m_PendingScanline;
+
       fifo.state = FetchState::Tile;
       fifo.lineX = 0;
       fifo.fetchX = 0;
@@ -426,15 +710,29 @@ namespace hijo {
     auto &lcd = LCD::Get();
     auto &bus = Gameboy::Get();
 
-    PipelineProcess();
+    if (m_Scanline) {
+      // Registers are read on the first dot of mode 3, like the fetcher does
+      if (lineTicks == m_OAMTicks + 1u) {
+        m_TransferEnd = m_OAMTicks + m_TransferDots[lcd.Regs().SCRX % 8];
+        RenderScanline();
+      }
 
-    if (fifo.pushedX >= m_XRes) {
-      PipelineFifoReset();
+      if (lineTicks < m_TransferEnd) {
+        return;
+      }
+    } else {
+      PipelineProcess();
 
-      lcd.LCDS_SetMode(LCD::Mode::HBlank);
-      if (lcd.LCDS_StatInt(LCD::StatSrc::HBlank)) {
-        Interrupts::RequestInterrupt(bus.m_Cpu, Interrupts::Interrupt::LCDStat);
+      if (fifo.pushedX < m_XRes) {
+        return;
       }
+
+      PipelineFifoReset();
+    }
+
+    lcd.LCDS_SetMode(LCD::Mode::HBlank);
+    if (lcd.LCDS_StatInt(LCD::StatSrc::HBlank)) {
+      Interrupts::RequestInterrupt(bus.m_Cpu, Interrupts::Interrupt::LCDStat);
     }
   }
 
@@ -456,6 +754,7 @@ namespace hijo {
         }
 
         currentFrame++;
+        videoBuffer.SetPalette(lcd.ShadeColors().data());
 
         // Cart save here
       } else {
@@ -519,50 +818,72 @@ namespace hijo {
     auto &lcd = LCD::Get();
     auto &lcdRegs = lcd.Regs();
 
-    int32_t curY = lcdRegs.LY;
     uint8_t sprHeight = lcd.LCDC_ObjHeight();
+
+    if (sprHeight != m_IndexedHeight) {
+      m_IndexedHeight = sprHeight;
+      RebuildSpriteIndex();
+    }
+
     memset(lineEntries, 0, sizeof(lineEntries));
 
-    for (auto i = 0; i < 40; i++) {
-      OAMEntry e = m_OAMRam[i];
+    if (lcdRegs.LY >= m_YRes)
+      return;
 
-      if (!e.x)
-        continue;
+    // The first ten candidates in OAM order...
+    uint64_t candidates = m_SpriteLines[lcdRegs.LY];
 
-      if (lineSpriteCount >= 10)
-        break;
+    while (candidates && lineSpriteCount < 10) {
+      lineEntries[lineSpriteCount++].entry = m_OAMRam[std::countr_zero(candidates)];
+      candidates &= candidates - 1;
+    }
 
-      if (e.y <= curY + 16 && e.y + sprHeight > curY + 16) {
-        OAMLineEntry *entry = &lineEntries[lineSpriteCount++];
+    // ...sorted by X, keeping OAM order between equal ones
+    for (auto i = 1; i < lineSpriteCount; i++) {
+      OAMLineEntry entry = lineEntries[i];
+      auto j = i;
 
-        entry->entry = e;
-        entry->next = nullptr;
+      while (j > 0 && lineEntries[j - 1].entry.x > entry.entry.x) {
+        lineEntries[j] = lineEntries[j - 1];
+        j--;
+      }
 
-        if (!lineSprites || lineSprites->entry.x > e.x) {
-          entry->next = lineSprites;
-          lineSprites = entry;
-          continue;
-        }
+      lineEntries[j] = entry;
+    }
 
-        OAMLineEntry *le = lineSprites;
-        OAMLineEntry *prev = le;
+    for (auto i = 0; i < lineSpriteCount; i++) {
+      lineEntries[i].next = i + 1 < lineSpriteCount ? &lineEntries[i + 1] : nullptr;
+    }
 
-        while (le) {
-          if (le->entry.x > e.x) {
-            prev->next = entry;
-            entry->next = le;
-            break;
-          }
+    lineSprites = lineSpriteCount ? &lineEntries[0] : nullptr;
+  }
 
-          if (!le->next) {
-            le->next = entry;
-            break;
-          }
+  void PPU::IndexSprite(size_t index, bool add) {
+    const auto &e = m_OAMRam[index];
 
-          prev = le;
-          le = le->next;
-        }
+    // Sprites at X 0 are never picked for a line
+    if (!e.x)
+      return;
+
+    uint64_t bit = uint64_t(1) << index;
+    int32_t top = e.y - 16;
+    int32_t first = std::max(top, 0);
+    int32_t last = std::min(top + m_IndexedHeight, static_cast<int32_t>(m_YRes));
+
+    for (auto line = first; line < last; line++) {
+      if (add) {
+        m_SpriteLines[line] |= bit;
+      } else {
+        m_SpriteLines[line] &= ~bit;
       }
     }
   }
+
+  void PPU::RebuildSpriteIndex() {
+    memset(m_SpriteLines, 0, sizeof(m_SpriteLines));
+
+    for (size_t i = 0; i < 40; i++) {
+      IndexSprite(i, true);
+    }
+  }
 } // hijo
\ No newline at end of file
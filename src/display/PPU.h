@@ -1,6 +1,7 @@
 #pragma once
 
-#include <raylib.h>
+#include "Framebuffer.h"
+#include "TileCache.h"
 #include <cstdint>
 #include <vector>
 
@@ -18,14 +19,26 @@ namespace hijo {
       Push
     };
 
+    enum class FifoPalette : uint8_t {
+      BGW = 0,
+      OBP0,
+      OBP1
+    };
+
+    // 2-bit color index and the palette it's looked up in once the pixel
+    // leaves the FIFO
     struct FifoEntry {
-      FifoEntry *next;
-      Color value;
+      uint8_t color;
+      FifoPalette palette;
     };
 
+    // Fixed ring buffer. The fetcher only pushes its 8 pixels while 8 or
+    // fewer are queued, so it never holds more than 16.
     struct Fifo {
-      FifoEntry *head;
-      FifoEntry *tail;
+      static constexpr uint32_t Capacity = 16;
+
+      FifoEntry entries[Capacity];
+      uint32_t head;
       uint32_t size;
     };
 
@@ -50,6 +63,8 @@ namespace hijo {
       uint8_t flags;
     };
 
+    static_assert(sizeof(OAMEntry) == 4, "OAM is copied into OAMEntry as bytes");
+
     static uint8_t OAMEntryCGBPalette(const OAMEntry &entry) {
       return entry.flags & 0x3;
     };
@@ -96,26 +111,70 @@ namespace hijo {
 
     void Tick();
 
+    // Runs the PPU for the given number of dots. Stretches where the only
+    // thing that changes is the dot counter (OAM scan once sprites are
+    // picked, HBlank, VBlank and the rest of mode 3 after a scanline
+    // render) are crossed in one step instead of dot by dot.
+    void Advance(uint64_t dots);
+
+    // Advances the PPU up to the given bus timestamp
+    void CatchUp(uint64_t target);
+
+    // Earliest bus timestamp at which the PPU can change mode or raise an interrupt
+    uint64_t NextEvent();
+
     void OAMWrite(uint16_t addr, uint8_t data);
 
+    // Writes count bytes of OAM at once, starting at offset
+    void OAMCopy(uint8_t offset, const uint8_t *data, size_t count);
+
+    // Bus timestamp of the next dot that picks sprites from OAM
+    uint64_t NextOAMScan();
+
     uint8_t OAMRead(uint16_t addr);
 
     void VRAMWrite(uint16_t addr, uint8_t data);
 
     uint8_t VRAMRead(uint16_t addr);
 
-    std::vector<Color> &VideoBuffer() {
+    Framebuffer &VideoBuffer() {
       return videoBuffer;
     }
 
+    // Draws each line in one pass when mode 3 starts instead of running the
+    // pixel FIFO every dot. Mode timing and interrupts are the same, but
+    // registers written during mode 3 only affect the following lines.
+    // Takes effect from the next line on.
+    void UseScanlineRenderer(bool enabled) {
+      m_PendingScanline = enabled;
+    }
+
+    bool UsingScanlineRenderer() const {
+      return m_PendingScanline;
+    }
+
+    TileCache &Tiles() {
+      return m_Tiles;
+    }
+
+    // Changes whenever either tilemap is written
+    uint32_t TilemapVersion() const {
+      return m_TilemapVersion;
+    }
+
   private:
     bool WindowVisible();
 
-    void PixelFifoPush(Color value);
+    void PixelFifoPush(FifoEntry value);
+
+    FifoEntry PixelFifoPop();
+
+    uint8_t PixelShade(FifoEntry pixel);
 
-    Color PixelFifoPop();
+    FifoEntry FetchSpritePixels(FifoEntry pixel, uint8_t bgColor);
 
-    Color FetchSpritePixels(uint8_t bit, Color color, uint8_t bgColor);
+    // Offset from 0x8000 of the sprite's tile row on the current line
+    uint16_t SpriteRowOffset(const OAMEntry &entry);
 
     bool PipelineFifoAdd();
 
@@ -133,6 +192,11 @@ namespace hijo {
 
     void PipelineFifoReset();
 
+    void RenderScanline();
+
+    // Length of mode 3 for the given SCX % 8, as the FIFO renderer takes it
+    uint32_t TransferDots(uint8_t fineX) const;
+
   private:
     void OAMMode();
 
@@ -146,6 +210,16 @@ namespace hijo {
 
     void LoadLineSprites();
 
+    // Adds or removes an OAM entry from the lines it covers
+    void IndexSprite(size_t index, bool add);
+
+    void RebuildSpriteIndex();
+
+    uint32_t NextEventDelay();
+
+    // Dots from now on that Tick would only count
+    uint32_t IdleDots();
+
   private:
     friend class UI;
 
@@ -160,19 +234,39 @@ namespace hijo {
 
     uint8_t fetchedEntryCount;
     OAMEntry fetchedEntries[3];
+    uint8_t m_SpriteRows[3][8];
     uint8_t windowLine;
 
     uint32_t currentFrame;
     uint32_t lineTicks;
-    std::vector<Color> videoBuffer;
+    Framebuffer videoBuffer;
+
+    uint64_t m_Timestamp = 0;
+
+    bool m_Scanline = false;
+    bool m_PendingScanline = false;
+    uint32_t m_TransferEnd = 0;
+    uint32_t m_TransferDots[8];
 
     OAMEntry m_OAMRam[40];
+
+    // One bit per OAM entry whose rows cover each visible line, for
+    // sprites of m_IndexedHeight. OAMWrite keeps it current.
+    uint64_t m_SpriteLines[144];
+    uint8_t m_IndexedHeight = 8;
+
     uint8_t m_VideoRam[1024 * 8];
+    TileCache m_Tiles{m_VideoRam};
+    uint32_t m_TilemapVersion = 0;
 
     const uint16_t m_LinesPerFrame = 154;
     const uint16_t m_TicksPerLine = 456;
+    const uint16_t m_OAMTicks = 80;
     const uint8_t m_YRes = 144;
-    const uint8_t m_XRes = 160;
+    static constexpr uint8_t m_XRes = 160;
+
+    // Pixels the scanline renderer composes, the line plus a fetch of fine scroll
+    static constexpr size_t m_StreamLength = m_XRes + 8;
   };
 
 } // hijo
@@ -0,0 +1,30 @@
+#include "TileCache.h"
+
+#include "Kernels.h"
+
+namespace hijo {
+
+  void TileCache::InvalidateAll() {
+    for (auto &dirty: m_Dirty) {
+      dirty = ~uint64_t(0);
+    }
+
+    m_Version++;
+  }
+
+  void TileCache::Decode(size_t tile) {
+    Kernels::DecodeTile(m_VideoRam + tile * TileBytes, &m_Pixels[0][tile][0][0]);
+
+    for (auto row = 0; row < 8; row++) {
+      const uint8_t *pixels = m_Pixels[0][tile][row];
+      uint8_t *flipped = m_Pixels[1][tile][row];
+
+      for (auto x = 0; x < 8; x++) {
+        flipped[x] = pixels[7 - x];
+      }
+    }
+
+    m_Dirty[tile / 64] &= ~(uint64_t(1) << (tile % 64));
+  }
+
+} // hijo
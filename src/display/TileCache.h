@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace hijo {
+
+  // The 384 tiles of VRAM decoded to one color index per pixel, plus their
+  // X-flipped copies. Writes to the tile area mark the tile dirty and it's
+  // decoded again the next time a row of it is asked for.
+  class TileCache {
+  public:
+    static constexpr size_t TileCount = 384;
+    static constexpr size_t TileBytes = 16;
+
+  public:
+    explicit TileCache(const uint8_t *vram) : m_VideoRam(vram) {
+      InvalidateAll();
+    }
+
+    // offset is relative to 0x8000
+    void Invalidate(uint16_t offset) {
+      size_t tile = offset / TileBytes;
+
+      if (tile < TileCount) {
+        m_Dirty[tile / 64] |= uint64_t(1) << (tile % 64);
+        m_Version++;
+      }
+    }
+
+    void InvalidateAll();
+
+    // Changes whenever a tile does, for viewers that redraw on change
+    uint32_t Version() const {
+      return m_Version;
+    }
+
+    // Eight color indices, left to right as drawn
+    const uint8_t *Row(size_t tile, uint8_t row, bool xflip = false) {
+      if (m_Dirty[tile / 64] & (uint64_t(1) << (tile % 64))) {
+        Decode(tile);
+      }
+
+      return m_Pixels[xflip][tile][row];
+    }
+
+  private:
+    void Decode(size_t tile);
+
+  private:
+    const uint8_t *m_VideoRam;
+
+    uint64_t m_Dirty[TileCount / 64];
+    uint32_t m_Version = 0;
+    uint8_t m_Pixels[2][TileCount][8][8];
+  };
+
+} // hijo
@@ -4,26 +4,6 @@
 #include "cpu/Interrupts.h"
 
 namespace hijo {
-  Controller::Controller() {
-    Init();
-  }
-
-  Controller::~Controller() {
-    EventManager::Get().DetachAll(this);
-  }
-
-  void Controller::Init() {
-    EventManager::Get().Attach<
-        Events::KeyDown,
-        &Controller::HandleKeyDown
-    >(this);
-
-    EventManager::Get().Attach<
-        Events::KeyUp,
-        &Controller::HandleKeyUp
-    >(this);
-  }
-
   bool Controller::ButtonSelected() {
     return m_ButtonSelected;
   }
@@ -81,48 +61,38 @@ namespace hijo {
     return output;
   }
 
-  void Controller::HandleKeyDown(const Events::KeyDown &event) {
-    bool pressed = false;
-
-    switch (event.key) {
-      case KEY_W:
-        m_Buttons.up = true;
-        pressed = true;
+  void Controller::SetButton(Button button, bool pressed) {
+    switch (button) {
+      case Button::Start:
+        m_Buttons.start = pressed;
         break;
 
-      case KEY_A:
-        m_Buttons.left = true;
-        pressed = true;
+      case Button::Select:
+        m_Buttons.select = pressed;
         break;
 
-      case KEY_S:
-        m_Buttons.down = true;
-        pressed = true;
+      case Button::A:
+        m_Buttons.a = pressed;
         break;
 
-      case KEY_D:
-        m_Buttons.right = true;
-        pressed = true;
+      case Button::B:
+        m_Buttons.b = pressed;
         break;
 
-      case KEY_ENTER:
-        m_Buttons.start = true;
-        pressed = true;
+      case Button::Up:
+        m_Buttons.up = pressed;
         break;
 
-      case KEY_TAB:
-        m_Buttons.select = true;
-        pressed = true;
+      case Button::Down:
+        m_Buttons.down = pressed;
         break;
 
-      case KEY_PERIOD:
-        m_Buttons.a = true;
-        pressed = true;
+      case Button::Left:
+        m_Buttons.left = pressed;
         break;
 
-      case KEY_COMMA:
-        m_Buttons.b = true;
-        pressed = true;
+      case Button::Right:
+        m_Buttons.right = pressed;
         break;
     }
 
@@ -133,42 +103,6 @@ namespace hijo {
     }
   }
 
-  void Controller::HandleKeyUp(const Events::KeyUp &event) {
-    switch (event.key) {
-      case KEY_W:
-        m_Buttons.up = false;
-        break;
-
-      case KEY_A:
-        m_Buttons.left = false;
-        break;
-
-      case KEY_S:
-        m_Buttons.down = false;
-        break;
-
-      case KEY_D:
-        m_Buttons.right = false;
-        break;
-
-      case KEY_ENTER:
-        m_Buttons.start = false;
-        break;
-
-      case KEY_TAB:
-        m_Buttons.select = false;
-        break;
-
-      case KEY_PERIOD:
-        m_Buttons.a = false;
-        break;
-
-      case KEY_COMMA:
-        m_Buttons.b = false;
-        break;
-    }
-  }
-
   void Controller::Reset() {
     m_ButtonSelected = false;
     m_DirectionSelected = false;
@@ -2,8 +2,6 @@
 
 #include <cstdint>
 
-#include "core/events/EventManager.h"
-
 namespace hijo {
 
   class Controller {
@@ -18,13 +16,19 @@ namespace hijo {
       bool left;
       bool right;
     };
-  public:
-    Controller();
 
-    ~Controller();
-
-    void Init();
+    enum class Button {
+      Start,
+      Select,
+      A,
+      B,
+      Up,
+      Down,
+      Left,
+      Right
+    };
 
+  public:
     void Reset();
 
     bool ButtonSelected();
@@ -39,10 +43,8 @@ namespace hijo {
       return m_Buttons;
     }
 
-  private:
-    void HandleKeyDown(const Events::KeyDown &event);
-
-    void HandleKeyUp(const Events::KeyUp &event);
+    // Called by the front-end, pressing a button raises the joypad interrupt
+    void SetButton(Button button, bool pressed);
 
   private:
     ButtonsState m_Buttons;
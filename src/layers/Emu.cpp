@@ -7,7 +7,55 @@
 #include "display/LCD.h"
 
 namespace hijo {
+  namespace {
+    bool JoypadButton(int key, Controller::Button &button) {
+      switch (key) {
+        case KEY_W:
+          button = Controller::Button::Up;
+          return true;
+
+        case KEY_A:
+          button = Controller::Button::Left;
+          return true;
+
+        case KEY_S:
+          button = Controller::Button::Down;
+          return true;
+
+        case KEY_D:
+          button = Controller::Button::Right;
+          return true;
+
+        case KEY_ENTER:
+          button = Controller::Button::Start;
+          return true;
+
+        case KEY_TAB:
+          button = Controller::Button::Select;
+          return true;
+
+        case KEY_PERIOD:
+          button = Controller::Button::A;
+          return true;
+
+        case KEY_COMMA:
+          button = Controller::Button::B;
+          return true;
+
+        default:
+          return false;
+      }
+    }
+  }
+
   void Emu::OnAttach() {
+    m_SoundQueue.start(48000, 2);
+
+    Image blank = GenImageColor(Framebuffer::Width, Framebuffer::Height, BLACK);
+    m_Screen = LoadTextureFromImage(blank);
+    SetTextureFilter(m_Screen, TEXTURE_FILTER_POINT);
+    UnloadImage(blank);
+
     EventManager::Get().Attach<
         Events::KeyPressed,
         &Emu::HandleKeyPress
@@ -17,10 +65,37 @@ namespace hijo {
         Events::InputAction,
         &Emu::HandleAction
     >(this);
+
+    EventManager::Get().Attach<
+        Events::KeyDown,
+        &Emu::HandleKeyDown
+    >(this);
+
+    EventManager::Get().Attach<
+        Events::KeyUp,
+        &Emu::HandleKeyUp
+    >(this);
+
+    EventManager::Get().Attach<
+        Events::AudioSamples,
+        &Emu::HandleAudioSamples
+    >(this);
+
+    EventManager::Get().Attach<
+        Events::ScreenShader,
+        &Emu::HandleScreenShader
+    >(this);
   }
 
   void Emu::OnDetach() {
     EventManager::Get().DetachAll(this);
+    m_SoundQueue.stop();
+
+    if (m_ScreenShader.id) {
+      UnloadShader(m_ScreenShader);
+    }
+
+    UnloadTexture(m_Screen);
   }
 
   void Emu::Update(double timestep) {
@@ -29,24 +104,30 @@ namespace hijo {
 
   void Emu::Render() {
     auto scw = app.ScreenWidth();
-    const auto &buffer = m_GB.VideoBuffer();
-    uint8_t bufferHeight = 144;
-    uint8_t bufferWidth = 160;
 
     if (!m_GB.CartridgeLoaded())
       return;
 
-    auto scale = scw / bufferWidth;
+    int32_t scale = scw / static_cast<int32_t>(Framebuffer::Width);
 
     auto &lcd = LCD::Get();
 
     if (lcd.LCDC_Enabled()) {
-      for (auto y = 0; y < bufferHeight; y++) {
-        for (auto x = 0; x < bufferWidth; x++) {
-          DrawRectangle(x * scale, y * scale,
-                        scale, scale,
-                        buffer[(y * bufferWidth) + x]);
-        }
+      m_GB.VideoBuffer().ToRGBA(m_Frame.data());
+      UpdateTexture(m_Screen, m_Frame.data());
+
+      Rectangle source{0, 0, static_cast<float>(Framebuffer::Width), static_cast<float>(Framebuffer::Height)};
+      Rectangle dest{0, 0, static_cast<float>(Framebuffer::Width * scale),
+                     static_cast<float>(Framebuffer::Height * scale)};
+
+      if (m_UseScreenShader) {
+        BeginShaderMode(m_ScreenShader);
+      }
+
+      DrawTexturePro(m_Screen, source, dest, {0, 0}, 0.0f, WHITE);
+
+      if (m_UseScreenShader) {
+        EndShaderMode();
       }
     }
   }
@@ -79,6 +160,41 @@ namespace hijo {
     }
   }
 
+  void Emu::HandleKeyDown(const Events::KeyDown &event) {
+    Controller::Button button;
+
+    if (JoypadButton(event.key, button)) {
+      m_GB.Joypad().SetButton(button, true);
+    }
+  }
+
+  void Emu::HandleKeyUp(const Events::KeyUp &event) {
+    Controller::Button button;
+
+    if (JoypadButton(event.key, button)) {
+      m_GB.Joypad().SetButton(button, false);
+    }
+  }
+
+  void Emu::HandleAudioSamples(const Events::AudioSamples &event) {
+    m_SoundQueue.write(event.samples, static_cast<int>(event.count));
+  }
+
   void Emu::RenderTexture() {
   }
+
+  void Emu::HandleScreenShader(const Events::ScreenShader &event) {
+    static constexpr const char *path = "assets/shaders/lcd.fs";
+
+    if (event.enabled && !m_ScreenShader.id) {
+      if (!FileExists(path)) {
+        spdlog::get("console")->warn("Screen shader {} not found", path);
+        return;
+      }
+
+      m_ScreenShader = LoadShader(nullptr, path);
+    }
+
+    m_UseScreenShader = event.enabled;
+  }
 } // hijo
\ No newline at end of file
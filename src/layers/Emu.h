@@ -7,6 +7,7 @@
 #include "core/layers/GameLayer.h"
 
 #include "system/Gameboy.h"
+#include "sound/Sound_Queue.h"
 
 namespace hijo {
 
@@ -34,10 +35,28 @@ namespace hijo {
 
     void HandleAction(const Events::InputAction &event);
 
+    void HandleKeyDown(const Events::KeyDown &event);
+
+    void HandleKeyUp(const Events::KeyUp &event);
+
+    void HandleAudioSamples(const Events::AudioSamples &event);
+
+    void HandleScreenShader(const Events::ScreenShader &event);
+
   private:
     Hijo &app = Hijo::Get();
 
     Gameboy &m_GB;
+
+    Sound_Queue m_SoundQueue;
+
+    // The current frame converted to colors, uploaded to m_Screen once per
+    // VBlank and scaled up by the GPU
+    std::vector<Pixel> m_Frame = std::vector<Pixel>(Framebuffer::Size);
+    Texture2D m_Screen{};
+
+    Shader m_ScreenShader{};
+    bool m_UseScreenShader = false;
   };
 
 } // hijo
@@ -7,8 +7,19 @@
 #include "cpu/Interrupts.h"
 #include "display/PPU.h"
 #include "display/LCD.h"
+#include "display/Kernels.h"
 
 namespace hijo {
+  namespace {
+    constexpr Pixel ViewerBackground{30, 30, 30, 255};
+
+    void DrawTile(TileCache &tiles, size_t tile, const Pixel *colors, Pixel *out, int stride) {
+      for (uint8_t row = 0; row < 8; row++) {
+        Kernels::ResolvePalette(tiles.Row(tile, row), colors, out + row * stride, 8);
+      }
+    }
+  }
+
   void UI::OnAttach() {
 // Hack to use opengl3 backend for imgui
     ImGui::CreateContext(nullptr);
@@ -43,6 +54,10 @@ namespace hijo {
   void UI::OnDetach() {
     EventManager::Get().DetachAll(this);
 
+    UnloadViewer(m_TileSheet);
+    UnloadViewer(m_PackedTiles);
+    UnloadViewer(m_Tilemap);
+
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplGlfw_Shutdown();
     ImGui::DestroyContext();
@@ -167,6 +182,10 @@ namespace hijo {
           ImGui::MenuItem("Tile Viewer", NULL, &m_ShowTiles);
           ImGui::MenuItem("OAM Viewer", NULL, &m_ShowOAM);
           ImGui::MenuItem("Tilemap 1 Viewer", NULL, &m_ShowTilemap1);
+          ImGui::Separator();
+          if (ImGui::MenuItem("LCD Shader", NULL, &m_ScreenShader)) {
+            EventManager::Dispatcher().trigger(Events::ScreenShader{m_ScreenShader});
+          }
           ImGui::EndMenu();
         }
 
@@ -191,9 +210,12 @@ namespace hijo {
       if (m_ShowRom) {
         static MemoryEditor romViewer;
 
+        // The image is mapped read-only
+        romViewer.ReadOnly = true;
 
-        if (gb->m_Cartridge) {
-          romViewer.DrawWindow("ROM", &gb->m_Cartridge->Data(), 32 * 1024);
+        if (gb->m_Cartridge && gb->m_Cartridge->Rom()) {
+          auto *rom = gb->m_Cartridge->Rom();
+          romViewer.DrawWindow("ROM", const_cast<uint8_t *>(rom->Data()), rom->Size());
         }
       }
 
@@ -212,6 +234,11 @@ namespace hijo {
       if (m_ShowVRAM) {
         static MemoryEditor vramEditor;
 
+        // Edits have to reach the tile cache
+        vramEditor.WriteFn = [](ImU8 *, size_t off, ImU8 d) {
+          Gameboy::Get().m_PPU.VRAMWrite(0x8000 + off, d);
+        };
+
         vramEditor.DrawWindow("VRAM", &gb->m_PPU.m_VideoRam, 8 * 1024, 0x8000);
       }
 
@@ -308,10 +335,11 @@ namespace hijo {
     if (!ImGui::Begin("Tiles", &m_ShowTiles)) {
       ImGui::End();
     } else {
-      auto &texture = Hijo::Get().GetTileTexture();
-      ImGui::Image(reinterpret_cast<ImTextureID>((uint64_t) texture.texture.id),
-                   {static_cast<float>(texture.texture.width), static_cast<float>(texture.texture.height)},
-                   {0, 1}, {1, 0});
+      RefreshTileSheet(m_TileSheet, 1);
+
+      auto &texture = m_TileSheet.texture;
+      ImGui::Image(reinterpret_cast<ImTextureID>((uint64_t) texture.id),
+                   {texture.width * 4.0f, texture.height * 4.0f});
 
       ImGui::End();
     }
@@ -642,6 +670,77 @@ namespace hijo {
 
       // Interrupts
 
+      ImGui::Separator();
+
+      bool useBlockCache = cpu.UsingBlockCache();
+      if (ImGui::Checkbox("Block Cache", &useBlockCache)) {
+        cpu.UseBlockCache(useBlockCache);
+      }
+
+      const auto &blockStats = cpu.BlockCacheStats();
+      ImGui::TextUnformatted(fmt::format("Blocks: {}  Hits: {}  Misses: {}  Invalidations: {}",
+                                         blockStats.blocks,
+                                         blockStats.hits,
+                                         blockStats.misses,
+                                         blockStats.invalidations).c_str());
+
+      if (Jit::Supported()) {
+        bool useJit = cpu.UsingJit();
+        if (ImGui::Checkbox("JIT", &useJit)) {
+          cpu.UseJit(useJit);
+        }
+
+        ImGui::SameLine();
+
+        bool lockstep = cpu.UsingJitLockstep();
+        if (ImGui::Checkbox("Lockstep", &lockstep)) {
+          cpu.UseJitLockstep(lockstep);
+        }
+
+        const auto &jitStats = cpu.JitStats();
+        ImGui::TextUnformatted(fmt::format("Compiled: {}  Runs: {}  Interpreted: {}  Code: {} bytes",
+                                           jitStats.compiled,
+                                           jitStats.executions,
+                                           jitStats.interpreted,
+                                           jitStats.codeBytes).c_str());
+        ImGui::TextUnformatted(fmt::format("Native: {} of {} instructions",
+                                           jitStats.nativeInstructions,
+                                           jitStats.instructions).c_str());
+        ImGui::TextUnformatted(fmt::format("Lockstep Checks: {}  Divergences: {}",
+                                           jitStats.lockstepChecks,
+                                           jitStats.divergences).c_str());
+      }
+
+      const auto &haltStats = cpu.GetHaltStats();
+      auto totalCycles = gb->TotalCycles();
+      ImGui::TextUnformatted(fmt::format("Halted: {}  Skipped: {} ({:.1f}% of {} cycles)",
+                                         haltStats.cycles,
+                                         haltStats.skipped,
+                                         totalCycles ? 100.0 * haltStats.skipped / totalCycles : 0.0,
+                                         totalCycles).c_str());
+
+      bool idleLoops = cpu.UsingIdleLoopSkip();
+      if (ImGui::Checkbox("Idle Loops", &idleLoops)) {
+        cpu.UseIdleLoopSkip(idleLoops);
+      }
+
+      ImGui::SameLine();
+
+      bool verifyIdle = cpu.VerifyingIdleLoops();
+      if (ImGui::Checkbox("Verify", &verifyIdle)) {
+        cpu.VerifyIdleLoops(verifyIdle);
+      }
+
+      const auto &idleStats = cpu.IdleLoopStats();
+      ImGui::TextUnformatted(fmt::format("Loops: {}  Skips: {}  Elided: {} cycles ({:.1f}%)",
+                                         idleStats.loops,
+                                         idleStats.skips,
+                                         idleStats.skippedCycles,
+                                         totalCycles ? 100.0 * idleStats.skippedCycles / totalCycles : 0.0).c_str());
+      ImGui::TextUnformatted(fmt::format("Verified: {}  Mismatches: {}",
+                                         idleStats.verified,
+                                         idleStats.mismatches).c_str());
+
       ImGui::End();
     }
   }
@@ -649,11 +748,12 @@ namespace hijo {
   void UI::OAM() {
     Gameboy *gb = app.System<Gameboy>();
     auto &oam = gb->m_PPU.m_OAMRam;
-    auto &texture = Hijo::Get().GetPackedTileTexture();
+    auto &texture = m_PackedTiles.texture;
 
     if (!ImGui::Begin("OAM", &m_ShowOAM)) {
       ImGui::End();
     } else {
+      RefreshTileSheet(m_PackedTiles, 0);
       ImGui::BeginTable("oam", 8, ImGuiTableFlags_ScrollY |
                                   ImGuiTableFlags_BordersOuterH |
                                   ImGuiTableFlags_BordersOuterV |
@@ -675,18 +775,15 @@ namespace hijo {
       for (size_t i = 0; i < 40; i++) {
         const auto &entry = oam[i];
 
-        int colCount = (int) (texture.texture.width / 32.0f);
+        int colCount = texture.width / 8;
         int tx = entry.tile % colCount;
-        int ty = (int) ((float) entry.tile / (float) colCount);
+        int ty = entry.tile / colCount;
 
-        float x = tx * 32.0f;
-        float y = ty * 32.0f;
+        float x = tx * 8.0f;
+        float y = ty * 8.0f;
 
-        ImVec2 uv0{x / texture.texture.width, y / texture.texture.height};
-        ImVec2 uv1{(x + 32.0f) / texture.texture.width, (y + 32.0f) / texture.texture.height};
-
-        uv0.y = -uv0.y;
-        uv1.y = -uv1.y;
+        ImVec2 uv0{x / texture.width, y / texture.height};
+        ImVec2 uv1{(x + 8.0f) / texture.width, (y + 8.0f) / texture.height};
 
         ImGui::TableNextRow();
         ImGui::TableSetColumnIndex(0);
@@ -697,7 +794,7 @@ namespace hijo {
         ImGui::Text("%d", entry.y);
         ImGui::TableNextColumn();
         ImGui::Text("%d", entry.tile);
-        ImGui::Image(reinterpret_cast<ImTextureID>((uint64_t) texture.texture.id),
+        ImGui::Image(reinterpret_cast<ImTextureID>((uint64_t) texture.id),
                      {32.0f, 32.0f},
                      uv0, uv1);
         ImGui::TableNextColumn();
@@ -1030,6 +1127,12 @@ namespace hijo {
 
           ImGui::EndTable();
 
+          bool scanline = ppu.UsingScanlineRenderer();
+          if (ImGui::Checkbox("Scanline Renderer", &scanline)) {
+            ppu.UseScanlineRenderer(scanline);
+          }
+          tooltip("Draw whole lines at the start of mode 3 instead of running the pixel FIFO");
+
           ImGui::Separator();
           ImGui::Text("Scroll");
 
@@ -1210,13 +1313,93 @@ namespace hijo {
     if (!ImGui::Begin("Tilemap", &m_ShowTilemap1)) {
       ImGui::End();
     } else {
-      auto &texture = Hijo::Get().GetTilemap1Texture();
-      ImGui::Image(reinterpret_cast<ImTextureID>((uint64_t) texture.texture.id),
-                   {static_cast<float>(texture.texture.width), static_cast<float>(texture.texture.height)},
-                   {0, 1}, {1, 0});
+      RefreshTilemap(m_Tilemap);
+
+      auto &texture = m_Tilemap.texture;
+      ImGui::Image(reinterpret_cast<ImTextureID>((uint64_t) texture.id),
+                   {texture.width * 2.0f, texture.height * 2.0f});
 
       ImGui::End();
     }
   }
 
+  /*
+   * Viewer textures
+   */
+
+  void UI::LoadViewer(ViewerTexture &viewer, int width, int height) {
+    Image blank = GenImageColor(width, height, BLANK);
+
+    viewer.texture = LoadTextureFromImage(blank);
+    SetTextureFilter(viewer.texture, TEXTURE_FILTER_POINT);
+    UnloadImage(blank);
+
+    viewer.pixels.assign(static_cast<size_t>(width) * height, ViewerBackground);
+    viewer.version = ~uint64_t(0);
+  }
+
+  void UI::UnloadViewer(ViewerTexture &viewer) {
+    if (viewer.texture.id) {
+      UnloadTexture(viewer.texture);
+      viewer.texture = {};
+    }
+  }
+
+  void UI::RefreshTileSheet(ViewerTexture &viewer, int gap) {
+    auto &tiles = Gameboy::Get().Video().Tiles();
+    int cell = 8 + gap;
+
+    if (!viewer.texture.id) {
+      LoadViewer(viewer, 16 * cell, 24 * cell);
+    }
+
+    if (viewer.version == tiles.Version())
+      return;
+
+    const Pixel *colors = LCD::Get().ShadeColors().data();
+    int stride = viewer.texture.width;
+
+    for (size_t tile = 0; tile < TileCache::TileCount; tile++) {
+      int x = static_cast<int>(tile % 16) * cell;
+      int y = static_cast<int>(tile / 16) * cell;
+
+      DrawTile(tiles, tile, colors, &viewer.pixels[y * stride + x], stride);
+    }
+
+    UpdateTexture(viewer.texture, viewer.pixels.data());
+    viewer.version = tiles.Version();
+  }
+
+  void UI::RefreshTilemap(ViewerTexture &viewer) {
+    auto &ppu = Gameboy::Get().Video();
+    auto &lcd = LCD::Get();
+    auto &tiles = ppu.Tiles();
+
+    if (!viewer.texture.id) {
+      LoadViewer(viewer, 32 * 8, 32 * 8);
+    }
+
+    bool altAddressing = lcd.LCDC_BGWTileDataArea() == 0x8800;
+    uint64_t version = static_cast<uint64_t>(ppu.TilemapVersion()) << 33 |
+                       static_cast<uint64_t>(tiles.Version()) << 1 | altAddressing;
+
+    if (viewer.version == version)
+      return;
+
+    const Pixel *colors = lcd.ShadeColors().data();
+    int stride = viewer.texture.width;
+    size_t tileBase = altAddressing ? 0x80 : 0;
+
+    for (uint16_t entry = 0; entry < 32 * 32; entry++) {
+      uint8_t tileNum = ppu.VRAMRead(0x9800 + entry) + (altAddressing * 128);
+      int x = (entry % 32) * 8;
+      int y = (entry / 32) * 8;
+
+      DrawTile(tiles, tileBase + tileNum, colors, &viewer.pixels[y * stride + x], stride);
+    }
+
+    UpdateTexture(viewer.texture, viewer.pixels.data());
+    viewer.version = version;
+  }
+
 } // hijo
\ No newline at end of file
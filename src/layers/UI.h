@@ -8,6 +8,8 @@
 #include "core/events/EventManager.h"
 #include "core/layers/GameLayer.h"
 
+#include "display/Framebuffer.h"
+
 #include "external/glfw/include/GLFW/glfw3.h"
 
 #include "external/imgui/imgui.h"
@@ -52,6 +54,24 @@ namespace hijo {
 
     void PPU();
 
+  private:
+    // A debug view drawn on the CPU and uploaded as a single texture. It's
+    // only redrawn while its window is open and VRAM changed since.
+    struct ViewerTexture {
+      Texture2D texture{};
+      std::vector<Pixel> pixels;
+      uint64_t version = ~uint64_t(0);
+    };
+
+    static void LoadViewer(ViewerTexture &viewer, int width, int height);
+
+    static void UnloadViewer(ViewerTexture &viewer);
+
+    // All 384 tiles, 16 to a row, gap pixels apart
+    static void RefreshTileSheet(ViewerTexture &viewer, int gap);
+
+    static void RefreshTilemap(ViewerTexture &viewer);
+
   private:
     ImVec2 GetLargestSizeForViewport();
 
@@ -78,6 +98,12 @@ namespace hijo {
     bool m_ShowCartridgeRuntime = true;
     bool m_ShowTilemap1 = true;
 
+    bool m_ScreenShader = false;
+
+    ViewerTexture m_TileSheet;
+    ViewerTexture m_PackedTiles;
+    ViewerTexture m_Tilemap;
+
     ImVec2 m_PreviousWindowSize{0, 0};
     ImVec2 m_PreviousMousePosition{0, 0};
 
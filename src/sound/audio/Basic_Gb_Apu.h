@@ -6,6 +6,8 @@
 #ifndef BASIC_GB_APU_H
 #define BASIC_GB_APU_H
 
+#include <cstdint>
+
 #include "Gb_Apu.h"
 #include "Multi_Buffer.h"
 
@@ -1,17 +1,28 @@
 #include "Gameboy.h"
 
-#include "core/Hijo.h"
+#include <algorithm>
+
+#include <spdlog/sinks/stdout_color_sinks.h>
+
+#include "system/Profiler.h"
 
 #include "display/LCD.h"
 
+#include "cartridge/mappers/ROM.h"
+#include "cartridge/mappers/MBC1.h"
+#include "cartridge/mappers/MBC2.h"
+#include "cartridge/mappers/MBC3.h"
+#include "cartridge/mappers/MBC5.h"
+
 #include "cpu/Interrupts.h"
 
 namespace hijo {
 
   Gameboy::Gameboy() {
-    auto &app = Hijo::Get();
-
-    app.System(this);
+    // Headless hosts don't go through Hijo, which normally sets up logging
+    if (!spdlog::get("console")) {
+      spdlog::stdout_color_mt("console");
+    }
 
     Reset();
 
@@ -47,26 +58,51 @@ namespace hijo {
   }
 
   Gameboy::~Gameboy() {
-    m_SoundQueue.stop();
     EventManager::Get().DetachAll(this);
   }
 
   void Gameboy::cpuWrite(uint16_t addr, uint8_t data) {
+    if (m_BusMode != BusMode::Normal) {
+      LoggedWrite(addr, data);
+      return;
+    }
+
+    // A running DMA has to copy its source bytes before they change
+    if (m_DMA.Transferring()) {
+      SyncVideo(m_Scheduler.Now());
+    }
+
+    if (auto *page = m_Map.WritePage(addr)) {
+      page[addr & 0xFF] = data;
+
+      if (addr >= 0xC000) {
+        m_Cpu.m_BlockCache.RamWrite(addr);
+      }
+      return;
+    }
+
     if (addr < 0x8000) {
-      m_Cartridge->Write(addr, data);
+      Profiler::Scope profile(Profiler::Section::Mapper);
+      CartridgeWrite(addr, data);
+      m_Cpu.m_BlockCache.MapRomBank(m_Cartridge->RomBank());
     } else if (addr < 0xA000) {
       //Char/Map Data
+      SyncVideo(m_Scheduler.Now());
       m_PPU.VRAMWrite(addr, data);
     } else if (addr < 0xC000) {
-      m_Cartridge->Write(addr, data);
+      Profiler::Scope profile(Profiler::Section::Mapper);
+      CartridgeWrite(addr, data);
     } else if (addr < 0xE000) {
       //WRAM
       m_WorkRam[addr & 0x1FFF] = data;
+      m_Cpu.m_BlockCache.RamWrite(addr);
     } else if (addr < 0xFE00) {
       // Mirror of WRAM
       m_WorkRam[addr & 0x1FFF] = data;
+      m_Cpu.m_BlockCache.RamWrite(addr);
     } else if (addr >= 0xFE00 && addr < 0xFEA0) {
       //OAM
+      SyncVideo(m_Scheduler.Now());
 
       if (m_DMA.Transferring()) {
         return;
@@ -100,13 +136,13 @@ namespace hijo {
           m_SerialTransfer = false;
         }
 
-        m_ControlSet = true;
-        m_ControlCount = false;
+        m_Scheduler.Schedule(Scheduler::Event::Serial, m_Scheduler.Now() + SerialTransferCycles);
         return;
       }
 
       if (IsBetween(addr, 0xFF04, 0xFF07)) {
         m_Timer.Write(addr, data);
+        ScheduleTimer();
         return;
       }
 
@@ -116,12 +152,15 @@ namespace hijo {
       }
 
       if (IsBetween(addr, 0xFF10, 0xFF3F)) {
+        Profiler::Scope profile(Profiler::Section::APU);
         m_APU.write_register(m_TCycleCount, addr, data);
         return;
       }
 
       if (IsBetween(addr, 0xFF40, 0xFF4B)) {
+        SyncVideo(m_Scheduler.Now());
         LCD::Get().Write(addr, data);
+        SchedulePPU();
         return;
       }
 
@@ -154,19 +193,30 @@ namespace hijo {
       m_Cpu.IERegister(data);
     } else {
       m_HighRam[addr & 0x7F] = data;
+      m_Cpu.m_BlockCache.RamWrite(addr);
     }
   }
 
   uint8_t Gameboy::cpuRead(uint16_t addr) {
+    if (m_BusMode != BusMode::Normal) {
+      return LoggedRead(addr);
+    }
+
+    if (const auto *page = m_Map.ReadPage(addr)) {
+      return page[addr & 0xFF];
+    }
+
     if (addr < 0x8000) {
       //ROM Data
-      return m_Cartridge->Read(addr);
+      Profiler::Scope profile(Profiler::Section::Mapper);
+      return CartridgeRead(addr);
     } else if (addr < 0xA000) {
       //Char/Map Data
       return m_PPU.VRAMRead(addr);
     } else if (addr < 0xC000) {
       //Cartridge RAM
-      return m_Cartridge->Read(addr);
+      Profiler::Scope profile(Profiler::Section::Mapper);
+      return CartridgeRead(addr);
     } else if (addr < 0xE000) {
       //WRAM (Working RAM)
       return m_WorkRam[addr & 0x1FFF];
@@ -174,6 +224,8 @@ namespace hijo {
       return m_WorkRam[addr & 0x1FFF];
     } else if (addr >= 0xFE00 && addr < 0xFEA0) {
       //OAM
+      SyncVideo(m_Scheduler.Now());
+
       if (m_DMA.Transferring()) {
         return 0xFF;
       }
@@ -205,10 +257,12 @@ namespace hijo {
       }
 
       if (IsBetween(addr, 0xFF10, 0xFF3F)) {
+        Profiler::Scope profile(Profiler::Section::APU);
         return m_APU.read_register(m_TCycleCount, addr);
       }
 
       if (IsBetween(addr, 0xFF40, 0xFF4B)) {
+        SyncVideo(m_Scheduler.Now());
         return LCD::Get().Read(addr);
       }
 
@@ -245,6 +299,56 @@ namespace hijo {
     return m_HighRam[addr & 0x7F];
   }
 
+  uint8_t Gameboy::CartridgeRead(uint16_t addr) {
+    switch (m_Cartridge->MapperType()) {
+      case Mapper::Type::ROM:
+        return m_Cartridge->Read<ROM>(addr);
+
+      case Mapper::Type::MBC1:
+        return m_Cartridge->Read<MBC1>(addr);
+
+      case Mapper::Type::MBC2:
+        return m_Cartridge->Read<MBC2>(addr);
+
+      case Mapper::Type::MBC3:
+        return m_Cartridge->Read<MBC3>(addr);
+
+      case Mapper::Type::MBC5:
+        return m_Cartridge->Read<MBC5>(addr);
+
+      default:
+        return m_Cartridge->Read(addr);
+    }
+  }
+
+  void Gameboy::CartridgeWrite(uint16_t addr, uint8_t data) {
+    switch (m_Cartridge->MapperType()) {
+      case Mapper::Type::ROM:
+        m_Cartridge->Write<ROM>(addr, data);
+        break;
+
+      case Mapper::Type::MBC1:
+        m_Cartridge->Write<MBC1>(addr, data);
+        break;
+
+      case Mapper::Type::MBC2:
+        m_Cartridge->Write<MBC2>(addr, data);
+        break;
+
+      case Mapper::Type::MBC3:
+        m_Cartridge->Write<MBC3>(addr, data);
+        break;
+
+      case Mapper::Type::MBC5:
+        m_Cartridge->Write<MBC5>(addr, data);
+        break;
+
+      default:
+        m_Cartridge->Write(addr, data);
+        break;
+    }
+  }
+
   void Gameboy::Update(double timestep) {
     // 154 Scanlines per Frame
     // 456 tcycles per scanline
@@ -256,44 +360,41 @@ namespace hijo {
 
     if (m_Run) {
 
-      m_Cartridge->Tick(timestep);
+      {
+        Profiler::Scope profile(Profiler::Section::Mapper);
+        m_Cartridge->Tick(timestep);
+      }
 
       do {
         if (m_TargetActive && m_Cpu.regs.pc == m_TargetAddr) {
           m_TargetActive = false;
           m_Run = false;
+          Sync();
           return;
         }
 
-        m_Cpu.Step();
-
-        if (m_ControlSet) {
-          m_ControlCount++;
+        m_Cpu.SkipIdleLoop();
 
-          if (m_ControlCount >= 10) {
-            m_Serial[0] = 0xFF;
-            SetBit(m_Serial[1], 7, 0);
-            Interrupts::RequestInterrupt(m_Cpu, Interrupts::Interrupt::Serial);
-            m_ControlCount = 0;
-            m_ControlSet = false;
-          }
+        if (!m_Cpu.RunCompiled()) {
+          m_Cpu.Step();
         }
 
-      } while (m_MCycleCount <= 17556);
+      } while (m_MCycleCount <= MCyclesPerFrame);
 
-      m_APU.end_frame(m_TCycleCount);
-      m_StereoBuffer.end_frame(m_TCycleCount);
+      Sync();
 
-      auto availSamples = m_StereoBuffer.samples_avail();
+      {
+        Profiler::Scope profile(Profiler::Section::APU);
 
-      if (availSamples > 0) {
-        m_SampleCount = m_StereoBuffer.read_samples(m_SampleBuffer, availSamples);
+        m_APU.end_frame(m_TCycleCount);
+        m_StereoBuffer.end_frame(m_TCycleCount);
 
-        for (auto i = 0u; i < m_SampleCount; i++) {
-          m_AudioBuffer[i] = m_SampleBuffer[i];
-        }
+        auto availSamples = m_StereoBuffer.samples_avail();
+        m_SampleCount = availSamples > 0 ? m_StereoBuffer.read_samples(m_SampleBuffer, availSamples) : 0;
+      }
 
-        m_SoundQueue.write(m_AudioBuffer, m_SampleCount);
+      if (m_SampleCount > 0) {
+        EventManager::Dispatcher().trigger(Events::AudioSamples{m_SampleBuffer, m_SampleCount});
       }
     }
   }
@@ -308,6 +409,7 @@ namespace hijo {
 
   void Gameboy::HandleCPUStep(const Events::StepCPU &) {
     m_Cpu.Step();
+    Sync();
   }
 
   void Gameboy::HandleLoadRom(const Events::LoadROM &event) {
@@ -334,20 +436,152 @@ namespace hijo {
 
   void Gameboy::InsertCartridge(const std::string &path) {
     m_Cartridge = Cartridge::Load(path);
+    m_Cartridge->Attach(m_Map);
+    m_Cpu.m_BlockCache.MapRomBank(m_Cartridge->RomBank());
   }
 
   void Gameboy::Cycles(uint32_t cycles) {
+    if (m_BusMode != BusMode::Normal) {
+      LoggedCycles(cycles);
+      return;
+    }
+
     m_MCycleCount += cycles;
+    m_TCycleCount += cycles * 4;
+    m_Scheduler.Advance(cycles * 4);
+
+    if (m_Scheduler.Due()) {
+      RunEvents();
+    }
+  }
+
+  uint32_t Gameboy::HaltCycles() const {
+    uint64_t untilFrameEnd = m_MCycleCount <= MCyclesPerFrame ? MCyclesPerFrame + 1 - m_MCycleCount : 1;
+    uint64_t next = m_Scheduler.NextDeadline();
+    uint64_t now = m_Scheduler.Now();
+
+    // The deadline fires in the M-cycle that reaches it
+    uint64_t untilEvent = next > now ? (next - now + 3) / 4 : 1;
+
+    return static_cast<uint32_t>(std::max<uint64_t>(1, std::min(untilEvent, untilFrameEnd)));
+  }
+
+  uint32_t Gameboy::QuietCycles() const {
+    if (m_MCycleCount > MCyclesPerFrame) {
+      return 0;
+    }
+
+    uint64_t quiet = MCyclesPerFrame - m_MCycleCount;
 
-    for (uint32_t i = 0; i < cycles; i++) {
-      for (auto n = 0; n < 4; n++) {
-        m_TCycleCount++;
-        m_Timer.Tick();
-        m_PPU.Tick();
+    if (m_BusMode == BusMode::Replay) {
+      // The recorded run is the only record of when its events raised an
+      // interrupt, stop short of the first cycle that changed IF
+      uint64_t logged = 0;
+
+      for (auto i = m_BusLogCursor; i < m_BusLog.size(); i++) {
+        const auto &event = m_BusLog[i];
+
+        if (event.type != BusEvent::Type::Cycles || event.intFlags != m_Cpu.m_IF) {
+          break;
+        }
+
+        logged += event.addr;
       }
 
-      m_DMA.Tick();
+      return static_cast<uint32_t>(std::min(quiet, logged));
+    }
+
+    uint64_t next = m_Scheduler.NextDeadline();
+    uint64_t now = m_Scheduler.Now();
+
+    // Stay clear of the M-cycle that reaches the deadline
+    uint64_t untilEvent = next > now ? (next - now - 1) / 4 : 0;
+
+    return static_cast<uint32_t>(std::min(quiet, untilEvent));
+  }
+
+  void Gameboy::RunEvents() {
+    Scheduler::Event event;
+    uint64_t deadline;
+
+    // Events can register new deadlines that are already due, keep going
+    // until everything up to now has been handled
+    while (m_Scheduler.Pop(event, deadline)) {
+      switch (event) {
+        case Scheduler::Event::Timer:
+          m_Timer.CatchUp(deadline);
+          ScheduleTimer();
+          break;
+
+        case Scheduler::Event::PPU:
+          SyncVideo(deadline);
+          SchedulePPU();
+          break;
+
+        case Scheduler::Event::DMA:
+          SyncVideo(deadline);
+          break;
+
+        case Scheduler::Event::Serial:
+          SerialComplete();
+          break;
+
+        default:
+          break;
+      }
+    }
+  }
+
+  void Gameboy::ScheduleTimer() {
+    auto deadline = m_Timer.NextOverflow();
+
+    if (deadline == Scheduler::Never) {
+      m_Scheduler.Cancel(Scheduler::Event::Timer);
+    } else {
+      m_Scheduler.Schedule(Scheduler::Event::Timer, deadline);
+    }
+  }
+
+  void Gameboy::SchedulePPU() {
+    m_Scheduler.Schedule(Scheduler::Event::PPU, m_PPU.NextEvent());
+  }
+
+  void Gameboy::SyncVideo(uint64_t target) {
+    // DMA source reads can land on the LCD registers
+    if (m_SyncingVideo) {
+      return;
     }
+
+    Profiler::Scope profile(Profiler::Section::PPU);
+
+    m_SyncingVideo = true;
+    m_DMA.CatchUp(target);
+    m_PPU.CatchUp(target);
+    m_SyncingVideo = false;
+  }
+
+  void Gameboy::Sync() {
+    SyncVideo(m_Scheduler.Now());
+    m_Timer.CatchUp(m_Scheduler.Now());
+  }
+
+  void Gameboy::MapMemory() {
+    m_Map.Clear();
+
+    // VRAM writes have to bring the PPU up to date first
+    m_Map.MapRead(0x8000, 0x2000, m_PPU.m_VideoRam);
+    m_Map.Map(0xC000, 0x2000, m_WorkRam);
+    m_Map.Map(0xE000, 0x1E00, m_WorkRam);
+
+    if (m_Cartridge) {
+      m_Cartridge->Attach(m_Map);
+    }
+  }
+
+  void Gameboy::SerialComplete() {
+    m_Serial[0] = 0xFF;
+    SetBit(m_Serial[1], 7, 0);
+    Interrupts::RequestInterrupt(m_Cpu, Interrupts::Interrupt::Serial);
   }
 
   void Gameboy::cpuWrite16(uint16_t addr, uint16_t value) {
@@ -362,13 +596,136 @@ namespace hijo {
     return low | (high << 8);
   }
 
-  void Gameboy::Reset(bool clearCartridge) {
-    m_Run = false;
+  void Gameboy::BeginBusRecord() {
+    m_BusLog.clear();
+    m_BusLogStartMCycles = m_MCycleCount;
+    m_BusLogStartTCycles = m_TCycleCount;
+    m_BusLogStartGeneration = m_Cpu.m_BlockCache.Generation();
+    m_BusMode = BusMode::Record;
+  }
+
+  void Gameboy::BeginBusReplay() {
+    m_BusLogEndMCycles = m_MCycleCount;
+    m_BusLogEndTCycles = m_TCycleCount;
+    m_BusLogEndGeneration = m_Cpu.m_BlockCache.Generation();
+
+    m_MCycleCount = m_BusLogStartMCycles;
+    m_TCycleCount = m_BusLogStartTCycles;
+    m_Cpu.m_BlockCache.Generation(m_BusLogStartGeneration);
+
+    m_BusLogCursor = 0;
+    m_BusLogMatched = true;
+    m_BusMode = BusMode::Replay;
+  }
+
+  bool Gameboy::EndBusReplay() {
+    m_BusMode = BusMode::Normal;
+
+    m_MCycleCount = m_BusLogEndMCycles;
+    m_TCycleCount = m_BusLogEndTCycles;
+    m_Cpu.m_BlockCache.Generation(m_BusLogEndGeneration);
+
+    return m_BusLogMatched && m_BusLogCursor == m_BusLog.size();
+  }
+
+  uint8_t Gameboy::LoggedRead(uint16_t addr) {
+    if (m_BusMode == BusMode::Replay) {
+      auto event = NextBusEvent(BusEvent::Type::Read, addr);
+      return event ? event->value : 0xFF;
+    }
+
+    m_BusMode = BusMode::Normal;
+    uint8_t value = cpuRead(addr);
+    m_BusMode = BusMode::Record;
+
+    m_BusLog.push_back({BusEvent::Type::Read, addr, value, m_Cpu.m_IF, m_MCycleCount,
+                        m_Cpu.m_BlockCache.Generation()});
+
+    return value;
+  }
+
+  void Gameboy::LoggedWrite(uint16_t addr, uint8_t data) {
+    if (m_BusMode == BusMode::Replay) {
+      auto event = NextBusEvent(BusEvent::Type::Write, addr);
+
+      if (!event) {
+        return;
+      }
+
+      if (event->value != data) {
+        m_BusLogMatched = false;
+      }
+
+      // Registers that live in the CPU still have to change on replay
+      if (addr == 0xFFFF) {
+        m_Cpu.IERegister(data);
+      }
+
+      m_Cpu.IntFlags(event->intFlags);
+      m_Cpu.m_BlockCache.Generation(event->blockGeneration);
+      return;
+    }
+
+    m_BusMode = BusMode::Normal;
+    cpuWrite(addr, data);
+    m_BusMode = BusMode::Record;
+
+    m_BusLog.push_back({BusEvent::Type::Write, addr, data, m_Cpu.m_IF, m_MCycleCount,
+                        m_Cpu.m_BlockCache.Generation()});
+  }
+
+  void Gameboy::LoggedCycles(uint32_t cycles) {
+    if (m_BusMode == BusMode::Replay) {
+      // Compiled code hands over the cycles of several native instructions
+      // at once, the interpreter logged them as they happened
+      while (cycles > 0) {
+        if (m_BusLogCursor >= m_BusLog.size() ||
+            m_BusLog[m_BusLogCursor].type != BusEvent::Type::Cycles ||
+            m_BusLog[m_BusLogCursor].addr > cycles) {
+          m_BusLogMatched = false;
+          return;
+        }
+
+        const auto &event = m_BusLog[m_BusLogCursor++];
+
+        cycles -= event.addr;
+        m_Cpu.m_IF = event.intFlags;
+        m_MCycleCount = event.mCycles;
+      }
 
-    if (m_SoundQueue.currently_playing()) {
-      m_SoundQueue.stop();
+      return;
     }
 
+    m_BusMode = BusMode::Normal;
+    Cycles(cycles);
+    m_BusMode = BusMode::Record;
+
+    m_BusLog.push_back({BusEvent::Type::Cycles, static_cast<uint16_t>(cycles), 0, m_Cpu.m_IF, m_MCycleCount,
+                        m_Cpu.m_BlockCache.Generation()});
+  }
+
+  const Gameboy::BusEvent *Gameboy::NextBusEvent(BusEvent::Type type, uint16_t addr) {
+    if (m_BusLogCursor >= m_BusLog.size()) {
+      m_BusLogMatched = false;
+      return nullptr;
+    }
+
+    const auto &event = m_BusLog[m_BusLogCursor];
+
+    if (event.type != type || event.addr != addr) {
+      m_BusLogMatched = false;
+      return nullptr;
+    }
+
+    m_BusLogCursor++;
+
+    return &event;
+  }
+
+  void Gameboy::Reset(bool clearCartridge) {
+    m_Run = false;
+
+    m_Scheduler.Reset();
     m_Cpu.Reset();
     m_DMA.Reset();
     m_Timer.Reset();
@@ -379,14 +736,18 @@ namespace hijo {
     if (clearCartridge)
       m_Cartridge = nullptr;
 
+    MapMemory();
+
     memset(m_WorkRam, 0, 1024 * 8);
     memset(m_HighRam, 0, 127);
     memset(m_Serial, 0, 2);
     memset(m_SampleBuffer, 0, sizeof(m_SampleBuffer));
-    memset(m_SampleBuffer, 0, sizeof(m_AudioBuffer));
 
     m_Timer.div = 0xABCC;
 
+    ScheduleTimer();
+    SchedulePPU();
+
     m_StereoBuffer.clear();
     m_StereoBuffer.clock_rate(4194304);
     m_StereoBuffer.set_sample_rate(48000);
@@ -395,8 +756,6 @@ namespace hijo {
     m_APU.set_output(m_StereoBuffer.center(),
                      m_StereoBuffer.left(),
                      m_StereoBuffer.right());
-
-    m_SoundQueue.start(48000, 2);
   }
 
 } // hijo
\ No newline at end of file
@@ -5,6 +5,8 @@
 #include <deque>
 
 #include "System.h"
+#include "Scheduler.h"
+#include "MemoryMap.h"
 #include "core/events/EventManager.h"
 
 #include "cpu/SharpSM83.h"
@@ -15,11 +17,17 @@
 #include "input/Controller.h"
 #include "sound/audio/Gb_Apu.h"
 #include "sound/audio/Multi_Buffer.h"
-#include "sound/Sound_Queue.h"
 
 namespace hijo {
 
   class Gameboy : public System {
+  public:
+    // 154 scanlines of 456 T-cycles
+    static constexpr uint32_t MCyclesPerFrame = 17556;
+
+    // 8 bits shifted out at 8192 Hz
+    static constexpr uint32_t SerialTransferCycles = 8 * 512;
+
   public:
     static Gameboy &Get() {
       static Gameboy instance;
@@ -41,8 +49,35 @@ namespace hijo {
 
     uint16_t cpuRead16(uint16_t addr);
 
+    // Opcode and operand reads. The lockstep checker leaves them out of the
+    // bus log, compiled blocks have their operands baked in.
+    uint8_t cpuFetch(uint16_t addr) {
+      if (m_BusMode != BusMode::Record) {
+        return cpuRead(addr);
+      }
+
+      m_BusMode = BusMode::Normal;
+      uint8_t value = cpuRead(addr);
+      m_BusMode = BusMode::Record;
+
+      return value;
+    }
+
     void Cycles(uint32_t cycles);
 
+    // M-cycles a halted CPU can idle in one go: up to the next scheduler
+    // deadline or the end of the frame, whichever comes first
+    uint32_t HaltCycles() const;
+
+    // M-cycles the CPU can run before a scheduler deadline is reached or the
+    // frame is over, so nothing else on the bus can notice it running ahead
+    uint32_t QuietCycles() const;
+
+    // Emulated M-cycles since the last reset
+    uint64_t TotalCycles() const {
+      return m_Scheduler.Now() / 4;
+    }
+
   public:
     void Update(double timestep) override;
 
@@ -56,16 +91,54 @@ namespace hijo {
       return m_TCycleCount;
     }
 
-    std::vector<Color> &VideoBuffer() {
+    Framebuffer &VideoBuffer() {
       return m_PPU.VideoBuffer();
     }
 
+    Controller &Joypad() {
+      return m_Controller;
+    }
+
+    SharpSM83 &Cpu() {
+      return m_Cpu;
+    }
+
+    PPU &Video() {
+      return m_PPU;
+    }
+
     bool CartridgeLoaded() {
       return m_Cartridge != nullptr;
     }
 
     void Reset(bool clearCartridge = true);
 
+  private:
+    // Handles every scheduler deadline reached by the current timestamp
+    void RunEvents();
+
+    void ScheduleTimer();
+
+    void SchedulePPU();
+
+    // Brings DMA and the PPU up to the timestamp, in bus order
+    void SyncVideo(uint64_t target);
+
+    // Brings every lazily updated component up to the current timestamp
+    void Sync();
+
+    // Cartridge accesses the page table can't serve, on the mapper type
+    // picked at load
+    uint8_t CartridgeRead(uint16_t addr);
+
+    void CartridgeWrite(uint16_t addr, uint8_t data);
+
+    // Rebuilds the page table: VRAM reads, WRAM and its echo, then whatever
+    // the cartridge maps
+    void MapMemory();
+
+    void SerialComplete();
+
     /* Events */
   private:
     void HandleCPUExecution(const Events::ExecuteCPU &event);
@@ -80,6 +153,47 @@ namespace hijo {
 
     void HandleUnloadRom(const Events::UnloadROM &event);
 
+    /* Bus logging for the JIT lockstep checker */
+  private:
+    struct BusEvent {
+      enum class Type : uint8_t {
+        Read,
+        Write,
+        Cycles
+      };
+
+      Type type;
+      uint16_t addr;
+      uint8_t value;
+      uint8_t intFlags;
+      uint32_t mCycles;
+      uint32_t blockGeneration;
+    };
+
+    enum class BusMode {
+      Normal,
+      Record,
+      Replay
+    };
+
+    // Logs CPU-initiated bus traffic while the machine runs normally
+    void BeginBusRecord();
+
+    // Rewinds the cycle counters and serves the recorded traffic back without
+    // touching the machine, so the same code can be run a second time
+    void BeginBusReplay();
+
+    // Returns true if the replayed run made exactly the recorded accesses
+    bool EndBusReplay();
+
+    uint8_t LoggedRead(uint16_t addr);
+
+    void LoggedWrite(uint16_t addr, uint8_t data);
+
+    void LoggedCycles(uint32_t cycles);
+
+    const BusEvent *NextBusEvent(BusEvent::Type type, uint16_t addr);
+
   private:
     friend class UI;
 
@@ -99,7 +213,7 @@ namespace hijo {
 
     friend class Controller;
 
-    friend class Display;
+    friend class IdleLoop;
 
   private:
     bool m_Run = false;
@@ -114,10 +228,13 @@ namespace hijo {
     // Serial
     uint8_t m_Serial[2];
     bool m_SerialTransfer = false;
-    bool m_ControlSet = false;
-    uint8_t m_ControlCount = 0;
     std::string m_Buffer;
 
+    Scheduler m_Scheduler;
+    bool m_SyncingVideo = false;
+
+    MemoryMap m_Map;
+
     // Things on the bus
     SharpSM83 m_Cpu;
     Timer m_Timer;
@@ -130,12 +247,22 @@ namespace hijo {
     uint16_t m_TargetAddr = 0;
     bool m_TargetActive = false;
 
+    // Lockstep Bus Log
+    BusMode m_BusMode = BusMode::Normal;
+    std::vector<BusEvent> m_BusLog;
+    size_t m_BusLogCursor = 0;
+    bool m_BusLogMatched = true;
+    uint32_t m_BusLogStartMCycles = 0;
+    uint32_t m_BusLogStartTCycles = 0;
+    uint32_t m_BusLogStartGeneration = 0;
+    uint32_t m_BusLogEndMCycles = 0;
+    uint32_t m_BusLogEndTCycles = 0;
+    uint32_t m_BusLogEndGeneration = 0;
+
     // APU
-    Sound_Queue m_SoundQueue;
     Gb_Apu m_APU{};
     Stereo_Buffer m_StereoBuffer{};
     blip_sample_t m_SampleBuffer[4096];
-    Sound_Queue::sample_t m_AudioBuffer[4096];
     uint32_t m_SampleCount = 0;
   };
 
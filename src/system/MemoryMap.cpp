@@ -0,0 +1,27 @@
+#include "MemoryMap.h"
+
+namespace hijo {
+
+  void MemoryMap::MapRead(uint16_t start, size_t size, const uint8_t *memory) {
+    for (size_t offset = 0; offset < size; offset += PageSize) {
+      m_Read[(start + offset) >> 8] = memory ? memory + offset : nullptr;
+    }
+  }
+
+  void MemoryMap::MapWrite(uint16_t start, size_t size, uint8_t *memory) {
+    for (size_t offset = 0; offset < size; offset += PageSize) {
+      m_Write[(start + offset) >> 8] = memory ? memory + offset : nullptr;
+    }
+  }
+
+  void MemoryMap::Unmap(uint16_t start, size_t size) {
+    MapRead(start, size, nullptr);
+    MapWrite(start, size, nullptr);
+  }
+
+  void MemoryMap::Clear() {
+    m_Read.fill(nullptr);
+    m_Write.fill(nullptr);
+  }
+
+} // hijo
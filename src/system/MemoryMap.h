@@ -0,0 +1,45 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace hijo {
+
+  // Direct pointers for each 256-byte page of the address space. Pages left
+  // unmapped, like I/O, OAM or mapper registers, go through the slow path of
+  // Gameboy::cpuRead/cpuWrite.
+  class MemoryMap {
+  public:
+    static constexpr size_t PageSize = 0x100;
+    static constexpr size_t PageCount = 0x100;
+
+  public:
+    const uint8_t *ReadPage(uint16_t addr) const {
+      return m_Read[addr >> 8];
+    }
+
+    uint8_t *WritePage(uint16_t addr) const {
+      return m_Write[addr >> 8];
+    }
+
+    // Maps [start, start + size) onto memory, size has to be a whole number of pages
+    void MapRead(uint16_t start, size_t size, const uint8_t *memory);
+
+    void MapWrite(uint16_t start, size_t size, uint8_t *memory);
+
+    void Map(uint16_t start, size_t size, uint8_t *memory) {
+      MapRead(start, size, memory);
+      MapWrite(start, size, memory);
+    }
+
+    void Unmap(uint16_t start, size_t size);
+
+    void Clear();
+
+  private:
+    std::array<const uint8_t *, PageCount> m_Read{};
+    std::array<uint8_t *, PageCount> m_Write{};
+  };
+
+} // hijo
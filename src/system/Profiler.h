@@ -0,0 +1,108 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace hijo {
+
+  // Attributes host time to the part of the machine that is running. Scopes
+  // switch the current section and switch back when they end, so nested
+  // scopes (a DMA read that lands in the mapper, say) are charged to the
+  // innermost one and the sections always add up to the wall time measured.
+  // Everything not inside a scope counts as CPU. With profiling off a scope
+  // is a load and a branch, cheap enough for the bus's per-access slow paths.
+  class Profiler {
+  public:
+    enum class Section : uint8_t {
+      CPU,
+      PPU,
+      APU,
+      Mapper,
+      Count
+    };
+
+    class Scope {
+    public:
+      explicit Scope(Section section) {
+        if (s_Enabled) [[unlikely]] {
+          m_Previous = Get().Switch(section);
+          m_Active = true;
+        }
+      }
+
+      ~Scope() {
+        if (m_Active) [[unlikely]] {
+          Get().Switch(m_Previous);
+        }
+      }
+
+      Scope(const Scope &) = delete;
+
+      Scope &operator=(const Scope &) = delete;
+
+    private:
+      Section m_Previous = Section::CPU;
+      bool m_Active = false;
+    };
+
+  public:
+    static Profiler &Get() {
+      static Profiler instance;
+
+      return instance;
+    }
+
+    bool Enabled() const {
+      return s_Enabled;
+    }
+
+    // Clears the totals and starts charging time to the CPU
+    void Enable(bool enabled) {
+      s_Enabled = enabled;
+      m_Nanoseconds.fill(0);
+      m_Current = Section::CPU;
+      m_Mark = Clock::now();
+    }
+
+    // Charges the time since the last switch to the current section
+    void Flush() {
+      if (s_Enabled) {
+        Switch(m_Current);
+      }
+    }
+
+    uint64_t Nanoseconds(Section section) const {
+      return m_Nanoseconds[static_cast<size_t>(section)];
+    }
+
+  private:
+    using Clock = std::chrono::steady_clock;
+
+    Profiler() = default;
+
+    Section Switch(Section section) {
+      auto now = Clock::now();
+      auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_Mark).count();
+
+      m_Nanoseconds[static_cast<size_t>(m_Current)] += elapsed;
+      m_Mark = now;
+
+      auto previous = m_Current;
+      m_Current = section;
+
+      return previous;
+    }
+
+  private:
+    // Static so a Scope doesn't go through Get()'s guard to find it
+    static inline bool s_Enabled = false;
+
+    Section m_Current = Section::CPU;
+    Clock::time_point m_Mark{};
+
+    std::array<uint64_t, static_cast<size_t>(Section::Count)> m_Nanoseconds{};
+  };
+
+} // hijo
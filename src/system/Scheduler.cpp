@@ -0,0 +1,52 @@
+#include "Scheduler.h"
+
+namespace hijo {
+
+  void Scheduler::Reset() {
+    m_Queue = {};
+    m_Sequence.fill(0);
+    m_Now = 0;
+    m_Next = Never;
+    m_Processed = 0;
+  }
+
+  void Scheduler::Schedule(Event event, uint64_t deadline) {
+    auto sequence = ++m_Sequence[static_cast<size_t>(event)];
+
+    m_Queue.push({deadline, sequence, event});
+    DropStale();
+  }
+
+  void Scheduler::Cancel(Event event) {
+    m_Sequence[static_cast<size_t>(event)]++;
+    DropStale();
+  }
+
+  bool Scheduler::Pop(Event &event, uint64_t &deadline) {
+    if (!Due()) {
+      return false;
+    }
+
+    auto entry = m_Queue.top();
+    m_Queue.pop();
+
+    // Popped events have to be scheduled again by their owner
+    m_Sequence[static_cast<size_t>(entry.event)]++;
+    DropStale();
+
+    event = entry.event;
+    deadline = entry.deadline;
+    m_Processed++;
+
+    return true;
+  }
+
+  void Scheduler::DropStale() {
+    while (!m_Queue.empty() && Stale(m_Queue.top())) {
+      m_Queue.pop();
+    }
+
+    m_Next = m_Queue.empty() ? Never : m_Queue.top().deadline;
+  }
+
+} // hijo
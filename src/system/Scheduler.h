@@ -0,0 +1,88 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <vector>
+
+namespace hijo {
+
+  // Global T-cycle timestamp plus the next deadline of each peripheral.
+  // Peripherals aren't ticked every cycle anymore: they catch up when the CPU
+  // touches their registers or when the deadline they registered comes up.
+  class Scheduler {
+  public:
+    enum class Event : uint8_t {
+      Timer,
+      PPU,
+      DMA,
+      Serial,
+      Count
+    };
+
+    static constexpr uint64_t Never = std::numeric_limits<uint64_t>::max();
+
+  public:
+    void Reset();
+
+    uint64_t Now() const {
+      return m_Now;
+    }
+
+    void Advance(uint32_t tcycles) {
+      m_Now += tcycles;
+    }
+
+    bool Due() const {
+      return m_Now >= m_Next;
+    }
+
+    uint64_t NextDeadline() const {
+      return m_Next;
+    }
+
+    // Number of events handled so far
+    uint64_t Processed() const {
+      return m_Processed;
+    }
+
+    // Replaces the pending deadline of the event, if any
+    void Schedule(Event event, uint64_t deadline);
+
+    void Cancel(Event event);
+
+    // Pops the earliest event whose deadline has been reached
+    bool Pop(Event &event, uint64_t &deadline);
+
+  private:
+    struct Entry {
+      uint64_t deadline;
+      uint32_t sequence;
+      Event event;
+
+      bool operator>(const Entry &other) const {
+        return deadline > other.deadline;
+      }
+    };
+
+    bool Stale(const Entry &entry) const {
+      return entry.sequence != m_Sequence[static_cast<size_t>(entry.event)];
+    }
+
+    void DropStale();
+
+  private:
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<>> m_Queue;
+
+    // Bumped whenever an event is rescheduled, older queue entries are skipped
+    std::array<uint32_t, static_cast<size_t>(Event::Count)> m_Sequence{};
+
+    uint64_t m_Now = 0;
+    uint64_t m_Next = Never;
+    uint64_t m_Processed = 0;
+  };
+
+} // hijo
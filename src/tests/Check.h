@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdio>
+#include <string>
+
+#include <fmt/format.h>
+
+/*
+ * Minimal checks for the headless test executables: every failed check
+ * prints where it happened, and Result() turns the tally into the exit
+ * code CTest looks at.
+ */
+
+namespace hijo::test {
+
+  inline int &Failures() {
+    static int failures = 0;
+
+    return failures;
+  }
+
+  inline void Fail(const char *file, int line, const std::string &message) {
+    std::fprintf(stderr, "%s:%d: %s\n", file, line, message.c_str());
+    Failures()++;
+  }
+
+  template<typename A, typename B>
+  void CheckEqual(const A &actual, const B &expected, const char *text, const char *file, int line) {
+    if (!(actual == expected)) {
+      Fail(file, line, fmt::format("{} is {}, expected {}", text, actual, expected));
+    }
+  }
+
+  inline int Result(const char *name) {
+    if (Failures()) {
+      std::fprintf(stderr, "%s: %d check(s) failed\n", name, Failures());
+      return 1;
+    }
+
+    std::printf("%s: ok\n", name);
+    return 0;
+  }
+
+} // hijo::test
+
+#define CHECK(expr) \
+  do { if (!(expr)) ::hijo::test::Fail(__FILE__, __LINE__, #expr); } while (0)
+
+#define CHECK_EQ(actual, expected) \
+  ::hijo::test::CheckEqual((actual), (expected), #actual, __FILE__, __LINE__)
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/*
+ * Cartridge images for the headless tests: zeroed ROM with the header bytes
+ * the mapper setup reads, optionally a program behind the entry point,
+ * written to the temp directory.
+ */
+
+namespace hijo::test {
+
+  struct Rom {
+    std::vector<uint8_t> bytes;
+
+    // Cartridge type, ROM size and RAM size as in the header at 0x147-0x149
+    explicit Rom(uint8_t type = 0x00, uint8_t romSize = 0x00, uint8_t ramSize = 0x00)
+        : bytes(size_t{0x8000} << romSize) {
+      bytes[0x147] = type;
+      bytes[0x148] = romSize;
+      bytes[0x149] = ramSize;
+    }
+
+    void Place(uint16_t addr, const std::vector<uint8_t> &code) {
+      std::copy(code.begin(), code.end(), bytes.begin() + addr);
+    }
+
+    // NOP; JP start at the entry point, the code at start
+    void Program(uint16_t start, const std::vector<uint8_t> &code) {
+      Place(0x100, {0x00, 0xC3, static_cast<uint8_t>(start & 0xFF), static_cast<uint8_t>(start >> 8)});
+      Place(start, code);
+    }
+
+    // Writes the image to name in the temp directory and returns its path
+    std::string Write(const std::string &name) const {
+      auto path = (std::filesystem::temp_directory_path() / name).string();
+
+      std::ofstream file(path, std::ios::binary);
+      file.write(reinterpret_cast<const char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+
+      return path;
+    }
+  };
+
+} // hijo::test
@@ -0,0 +1,169 @@
+#include <atomic>
+#include <cstdlib>
+#include <filesystem>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "core/events/EventManager.h"
+#include "system/Gameboy.h"
+#include "tests/Check.h"
+#include "tests/Rom.h"
+
+/*
+ * hijo-allocations-test: counts every operator new made by Gameboy::Update
+ * while a ROM without battery RAM draws background, window and sprites,
+ * and checks a frame doesn't touch the heap once the machine is warm.
+ */
+
+namespace {
+  std::atomic<bool> s_Counting = false;
+  std::atomic<size_t> s_Allocations = 0;
+
+  void *Allocate(std::size_t size) {
+    if (s_Counting) {
+      s_Allocations++;
+    }
+
+    if (void *memory = std::malloc(size ? size : 1)) {
+      return memory;
+    }
+
+    throw std::bad_alloc();
+  }
+
+  void *AllocateAligned(std::size_t size, std::align_val_t alignment) {
+    if (s_Counting) {
+      s_Allocations++;
+    }
+
+    auto align = static_cast<std::size_t>(alignment);
+
+    if (void *memory = std::aligned_alloc(align, (size + align - 1) / align * align)) {
+      return memory;
+    }
+
+    throw std::bad_alloc();
+  }
+}
+
+void *operator new(std::size_t size) { return Allocate(size); }
+
+void *operator new[](std::size_t size) { return Allocate(size); }
+
+void *operator new(std::size_t size, std::align_val_t alignment) { return AllocateAligned(size, alignment); }
+
+void *operator new[](std::size_t size, std::align_val_t alignment) { return AllocateAligned(size, alignment); }
+
+void operator delete(void *memory) noexcept { std::free(memory); }
+
+void operator delete[](void *memory) noexcept { std::free(memory); }
+
+void operator delete(void *memory, std::size_t) noexcept { std::free(memory); }
+
+void operator delete[](void *memory, std::size_t) noexcept { std::free(memory); }
+
+void operator delete(void *memory, std::align_val_t) noexcept { std::free(memory); }
+
+void operator delete[](void *memory, std::align_val_t) noexcept { std::free(memory); }
+
+void operator delete(void *memory, std::size_t, std::align_val_t) noexcept { std::free(memory); }
+
+void operator delete[](void *memory, std::size_t, std::align_val_t) noexcept { std::free(memory); }
+
+namespace {
+  using namespace hijo;
+
+  constexpr double Timestep = 1.0 / 59.7275;
+
+  // Turns on background, window and sprites, fills OAM with 40 sprites
+  // over a solid tile and then spins
+  const std::vector<uint8_t> Program = {
+      0x3E, 0xFF,             // LD A, 0xFF
+      0x21, 0x10, 0x80,       // LD HL, 0x8010
+      0x06, 0x10,             // LD B, 16
+      0x22,                   // tile: LD (HL+), A
+      0x05,                   // DEC B
+      0x20, 0xFC,             // JR NZ, tile
+      0x21, 0x00, 0xFE,       // LD HL, 0xFE00
+      0x06, 0x28,             // LD B, 40
+      0x78,                   // sprite: LD A, B
+      0x87,                   // ADD A, A
+      0x87,                   // ADD A, A
+      0x22,                   // LD (HL+), A      y
+      0x22,                   // LD (HL+), A      x
+      0x3E, 0x01,             // LD A, 1
+      0x22,                   // LD (HL+), A      tile
+      0x78,                   // LD A, B
+      0xE6, 0x20,             // AND 0x20
+      0x22,                   // LD (HL+), A      attributes
+      0x05,                   // DEC B
+      0x20, 0xF1,             // JR NZ, sprite
+      0x3E, 0x28,             // LD A, 40
+      0xE0, 0x4A,             // LDH (WY), A
+      0x3E, 0x50,             // LD A, 80
+      0xE0, 0x4B,             // LDH (WX), A
+      0x3E, 0xE3,             // LD A, LCD | window | sprites | background
+      0xE0, 0x40,             // LDH (LCDC), A
+      0x18, 0xFE              // JR -2
+  };
+
+  // Plain 32k ROM, no RAM and no battery
+  std::string MakeRom() {
+    test::Rom rom;
+    rom.Program(0x150, Program);
+
+    return rom.Write("hijo-allocations-test.gb");
+  }
+
+  void FramesDontAllocate(bool scanline) {
+    auto &gb = Gameboy::Get();
+
+    gb.Video().UseScanlineRenderer(scanline);
+
+    // Let lazily sized buffers reach their steady state first
+    for (int frame = 0; frame < 10; frame++) {
+      gb.Update(Timestep);
+    }
+
+    uint64_t cycles = gb.TotalCycles();
+
+    s_Allocations = 0;
+    s_Counting = true;
+
+    for (int frame = 0; frame < 60; frame++) {
+      gb.Update(Timestep);
+    }
+
+    s_Counting = false;
+
+    CHECK_EQ(s_Allocations.load(), size_t{0});
+    CHECK(gb.TotalCycles() - cycles >= 60 * Gameboy::MCyclesPerFrame);
+
+    // The frame has background, window and sprite pixels in it
+    const auto &frame = gb.VideoBuffer();
+    bool mixed = false;
+
+    for (size_t i = 1; i < Framebuffer::Size; i++) {
+      mixed = mixed || frame.Data()[i] != frame.Data()[0];
+    }
+
+    CHECK(mixed);
+  }
+}
+
+int main() {
+  auto path = MakeRom();
+
+  // The bus only hears LoadROM once it exists
+  Gameboy::Get();
+
+  EventManager::Dispatcher().trigger(Events::LoadROM{path});
+
+  FramesDontAllocate(false);
+  FramesDontAllocate(true);
+
+  std::filesystem::remove(path);
+
+  return hijo::test::Result("hijo-allocations-test");
+}
@@ -0,0 +1,268 @@
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <spdlog/sinks/stdout_color_sinks.h>
+
+#include "cartridge/BatteryRam.h"
+#include "cartridge/Cartridge.h"
+#include "tests/Check.h"
+#include "tests/Rom.h"
+
+/*
+ * hijo-battery-test: checks that battery saves are replaced by writing
+ * <rom>.sav.tmp and renaming it, so the save is never half written, and
+ * that the writer flushes on RAM-disable, on the interval and when the
+ * cartridge goes away. Files live in the temp directory.
+ */
+
+namespace {
+  using namespace hijo;
+
+  constexpr size_t RamSize = 4 * CartRam::BankSize;
+
+  namespace fs = std::filesystem;
+
+  std::vector<uint8_t> ReadAll(const std::string &path) {
+    std::ifstream file(path, std::ios::binary);
+
+    return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+  }
+
+  void WriteAll(const std::string &path, const std::vector<uint8_t> &bytes) {
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+  }
+
+  std::vector<uint8_t> Pattern(uint8_t seed) {
+    std::vector<uint8_t> bytes(RamSize);
+
+    for (size_t i = 0; i < bytes.size(); i++) {
+      bytes[i] = static_cast<uint8_t>(seed + i * 7 + (i >> 8));
+    }
+
+    return bytes;
+  }
+
+  // Everything a save's replace hook saw, in order
+  struct Replacements {
+    struct Snapshot {
+      std::vector<uint8_t> save;
+      std::vector<uint8_t> temp;
+      bool saveExists;
+    };
+
+    std::mutex lock;
+    std::condition_variable changed;
+    std::vector<Snapshot> seen;
+
+    BatteryRam::ReplaceHook Hook() {
+      return [this](const std::string &temp) {
+        auto save = temp.substr(0, temp.size() - 4);
+
+        std::lock_guard<std::mutex> guard(lock);
+        seen.push_back({ReadAll(save), ReadAll(temp), fs::exists(save)});
+        changed.notify_all();
+      };
+    }
+
+    size_t Count() {
+      std::lock_guard<std::mutex> guard(lock);
+      return seen.size();
+    }
+
+    // Waits for the writer to reach the rename count times in total
+    bool WaitFor(size_t count) {
+      std::unique_lock<std::mutex> guard(lock);
+
+      return changed.wait_for(guard, std::chrono::seconds(5), [&] { return seen.size() >= count; });
+    }
+  };
+
+  std::string Path(const std::string &name) {
+    return (fs::temp_directory_path() / ("hijo-battery-test-" + name)).string();
+  }
+
+  void Remove(const std::string &save) {
+    fs::remove(save);
+    fs::remove(save + ".tmp");
+  }
+
+  // Saves made through a Cartridge have no hook, the rename making the file
+  // appear is what shows the writer got there
+  bool WaitForFile(const std::string &path) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+
+    while (!fs::exists(path)) {
+      if (std::chrono::steady_clock::now() > deadline) {
+        return false;
+      }
+
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    return true;
+  }
+
+  // While only the temp file has been written the save still holds the
+  // old image, and the rename swaps in the whole new one
+  void WriteThenRename() {
+    auto save = Path("crash.sav");
+    auto before = Pattern(0x11);
+
+    Remove(save);
+    WriteAll(save, before);
+
+    auto expected = before;
+    Replacements replacements;
+
+    {
+      BatteryRam ram(save, RamSize, replacements.Hook());
+      CHECK(std::equal(before.begin(), before.end(), ram.Data()));
+
+      // A few scattered pages, the rest has to come through unchanged
+      for (size_t offset: {size_t{0x0010}, size_t{0x1234}, size_t{0x7FFF}}) {
+        ram.Data()[offset] ^= 0xFF;
+        expected[offset] ^= 0xFF;
+        ram.MarkDirty(offset);
+      }
+
+      ram.Flush();
+      CHECK(replacements.WaitFor(1));
+    }
+
+    CHECK_EQ(replacements.Count(), size_t{1});
+
+    if (replacements.Count() > 0) {
+      const auto &snapshot = replacements.seen[0];
+
+      CHECK(snapshot.saveExists);
+      CHECK(snapshot.save == before);
+      CHECK(snapshot.temp == expected);
+    }
+
+    CHECK(ReadAll(save) == expected);
+    CHECK(!fs::exists(save + ".tmp"));
+
+    // A crash before the rename leaves a stale temp file next to the old
+    // save, which is what gets loaded
+    WriteAll(save + ".tmp", Pattern(0x55));
+
+    {
+      BatteryRam ram(save, RamSize);
+      CHECK(std::equal(expected.begin(), expected.end(), ram.Data()));
+    }
+
+    Remove(save);
+  }
+
+  // A battery MBC1 cart with 4 RAM banks
+  std::string MakeRom(const std::string &name) {
+    auto path = test::Rom(0x03, 0x01, 0x03).Write("hijo-battery-test-" + name);
+
+    Remove(path + ".sav");
+
+    return path;
+  }
+
+  void FlushOnRamDisable() {
+    auto rom = MakeRom("disable.gb");
+
+    {
+      auto cartridge = Cartridge::Load(rom);
+
+      cartridge->Write(0x0000, 0x0A);
+      cartridge->Write(0xA000, 0x42);
+      cartridge->Write(0xA100, 0x43);
+
+      // Writes alone stay in memory
+      CHECK(!fs::exists(rom + ".sav"));
+
+      cartridge->Write(0x0000, 0x00);
+      CHECK(WaitForFile(rom + ".sav"));
+
+      auto save = ReadAll(rom + ".sav");
+      CHECK_EQ(save.size(), RamSize);
+      CHECK(save.size() > 0x100 && save[0] == 0x42 && save[0x100] == 0x43);
+
+      Remove(rom + ".sav");
+    }
+
+    // Nothing dirty, nothing written on the way out
+    CHECK(!fs::exists(rom + ".sav"));
+
+    Remove(rom + ".sav");
+    fs::remove(rom);
+  }
+
+  void FlushOnInterval() {
+    auto rom = MakeRom("interval.gb");
+
+    {
+      auto cartridge = Cartridge::Load(rom);
+
+      cartridge->Write(0x0000, 0x0A);
+      cartridge->Write(0xBFFF, 0x99);
+
+      cartridge->Tick(BatteryRam::FlushInterval / 2);
+      CHECK(!fs::exists(rom + ".sav"));
+
+      cartridge->Tick(BatteryRam::FlushInterval / 2);
+      CHECK(WaitForFile(rom + ".sav"));
+
+      auto save = ReadAll(rom + ".sav");
+      CHECK(save.size() == RamSize && save[0x1FFF] == 0x99);
+
+      // The interval starts over and a clean RAM isn't written again
+      Remove(rom + ".sav");
+      cartridge->Tick(BatteryRam::FlushInterval);
+    }
+
+    // Destruction waits for the writer, so anything requested is done
+    CHECK(!fs::exists(rom + ".sav"));
+
+    Remove(rom + ".sav");
+    fs::remove(rom);
+  }
+
+  void FlushOnDestruction() {
+    auto rom = MakeRom("shutdown.gb");
+
+    {
+      auto cartridge = Cartridge::Load(rom);
+
+      cartridge->Write(0x0000, 0x0A);
+      cartridge->Write(0x4000, 0x02);
+      cartridge->Write(0xA080, 0x5A);
+
+      CHECK(!fs::exists(rom + ".sav"));
+    }
+
+    // Destruction waits for the writer
+    CHECK(fs::exists(rom + ".sav"));
+
+    auto save = ReadAll(rom + ".sav");
+    CHECK(save.size() == RamSize && save[2 * CartRam::BankSize + 0x80] == 0x5A);
+    CHECK(!fs::exists(rom + ".sav.tmp"));
+
+    Remove(rom + ".sav");
+    fs::remove(rom);
+  }
+}
+
+int main() {
+  spdlog::stderr_color_mt("console");
+
+  WriteThenRename();
+  FlushOnRamDisable();
+  FlushOnInterval();
+  FlushOnDestruction();
+
+  return hijo::test::Result("hijo-battery-test");
+}
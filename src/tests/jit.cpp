@@ -0,0 +1,296 @@
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "core/events/EventManager.h"
+#include "system/Gameboy.h"
+#include "tests/Check.h"
+#include "tests/Rom.h"
+
+/*
+ * hijo-jit-test: runs a generated ROM of random register, ALU and flag
+ * code, mixed with memory stores, CB ops, DI/EI and HALT under a fast
+ * timer interrupt, once on the plain interpreter and then through the JIT,
+ * with and without lockstep. Every run has to end in the same state.
+ */
+
+namespace {
+  using namespace hijo;
+
+  constexpr double Timestep = 1.0 / 59.7275;
+  constexpr int Frames = 30;
+
+  constexpr uint16_t Origin = 0x150;
+  constexpr uint16_t Log = 0xC000;
+  constexpr uint16_t LogSize = 0x800;
+  constexpr uint16_t TimerCount = 0xC800;
+
+  // B, C, D, E, H, L, A in opcode order, (HL) left out
+  constexpr uint8_t Registers[] = {0, 1, 2, 3, 4, 5, 7};
+
+  struct Generator {
+    std::mt19937 rng{0x4A495421};
+    std::vector<uint8_t> code;
+    uint16_t logged = 0;
+
+    uint16_t Address() const {
+      return static_cast<uint16_t>(Origin + code.size());
+    }
+
+    uint32_t Random(uint32_t n) {
+      return rng() % n;
+    }
+
+    uint8_t Reg() {
+      return Registers[Random(7)];
+    }
+
+    void Emit(std::initializer_list<uint8_t> bytes) {
+      code.insert(code.end(), bytes);
+    }
+
+    void Emit16(uint8_t opcode, uint16_t value) {
+      Emit({opcode, static_cast<uint8_t>(value & 0xFF), static_cast<uint8_t>(value >> 8)});
+    }
+
+    // One instruction the JIT runs as native code
+    void Native() {
+      switch (Random(12)) {
+        case 0: {
+          uint8_t dst = Reg();
+          uint8_t src = Reg();
+          Emit({static_cast<uint8_t>(0x40 | (dst << 3) | src)});
+          break;
+        }
+        case 1:
+          Emit({static_cast<uint8_t>(0x06 | (Reg() << 3)), static_cast<uint8_t>(rng())});
+          break;
+        case 2:
+          Emit16(static_cast<uint8_t>(0x01 | (Random(3) << 4)), static_cast<uint16_t>(rng()));
+          break;
+        case 3:
+        case 4:
+          Emit({static_cast<uint8_t>(0x80 | (Random(8) << 3) | Reg())});
+          break;
+        case 5:
+          Emit({static_cast<uint8_t>(0xC6 | (Random(8) << 3)), static_cast<uint8_t>(rng())});
+          break;
+        case 6:
+          Emit({static_cast<uint8_t>(0x04 | Random(2) | (Reg() << 3))});
+          break;
+        case 7:
+          Emit({static_cast<uint8_t>(0x03 | (Random(2) << 3) | (Random(3) << 4))});
+          break;
+        case 8:
+          Emit({static_cast<uint8_t>(0x09 | (Random(4) << 4))});
+          break;
+        case 9: {
+          static constexpr uint8_t ops[] = {0x00, 0x07, 0x0F, 0x17, 0x1F, 0x2F, 0x37, 0x3F};
+          Emit({ops[Random(8)]});
+          break;
+        }
+        case 10:
+          // INC SP; DEC SP
+          Emit({0x33, 0x3B});
+          break;
+        default:
+          // LD HL, 0xDFF0; LD SP, HL
+          Emit16(0x21, 0xDFF0);
+          Emit({0xF9});
+          break;
+      }
+    }
+
+    // A jump that skips the native instruction after it, taken or not
+    void Jump() {
+      static constexpr uint8_t conditions[] = {0x00, 0x08, 0x10, 0x18};
+      std::vector<uint8_t> skipped;
+
+      std::swap(code, skipped);
+      Native();
+      std::swap(code, skipped);
+
+      switch (Random(4)) {
+        case 0:
+          Emit({static_cast<uint8_t>(0x20 | conditions[Random(4)]), static_cast<uint8_t>(skipped.size())});
+          break;
+        case 1:
+          Emit({0x18, static_cast<uint8_t>(skipped.size())});
+          break;
+        case 2:
+          Emit16(static_cast<uint8_t>(Random(2) ? 0xC3 : 0xC2 | conditions[Random(4)]),
+                 static_cast<uint16_t>(Address() + 3 + skipped.size()));
+          break;
+        default:
+          // LD HL, target; JP HL
+          Emit16(0x21, static_cast<uint16_t>(Address() + 4 + skipped.size()));
+          Emit({0xE9});
+          break;
+      }
+
+      code.insert(code.end(), skipped.begin(), skipped.end());
+    }
+
+    // Stores A and F to the next two log bytes
+    void Record() {
+      uint16_t addr = Log + logged;
+      logged = (logged + 2) % LogSize;
+
+      // PUSH AF; POP BC; LD A, C; LD (addr), A; LD A, B; LD (addr + 1), A
+      Emit({0xF5, 0xC1, 0x79});
+      Emit16(0xEA, addr);
+      Emit({0x78});
+      Emit16(0xEA, static_cast<uint16_t>(addr + 1));
+    }
+
+    // Something that goes through the CPU's handlers
+    void Handler() {
+      switch (Random(6)) {
+        case 0:
+        case 1:
+          Record();
+          break;
+        case 2:
+          // DAA
+          Emit({0x27});
+          break;
+        case 3:
+          Emit({0xCB, static_cast<uint8_t>((Random(32) << 3) | Reg())});
+          break;
+        case 4:
+          // DI; <native>; EI
+          Emit({0xF3});
+          Native();
+          Emit({0xFB});
+          break;
+        default:
+          // HALT, the timer wakes it up
+          Emit({0x76});
+          break;
+      }
+    }
+  };
+
+  std::string MakeRom() {
+    test::Rom rom;
+
+    // Timer interrupt: counts itself in WRAM
+    rom.Place(0x50, {
+        0xF5,             // PUSH AF
+        0xFA, 0x00, 0xC8, // LD A, (TimerCount)
+        0x3C,             // INC A
+        0xEA, 0x00, 0xC8, // LD (TimerCount), A
+        0xF1,             // POP AF
+        0xD9              // RETI
+    });
+
+    Generator gen;
+
+    gen.Emit({0xF3});               // DI
+    gen.Emit16(0x31, 0xDFF0);       // LD SP, 0xDFF0
+    gen.Emit({0x3E, 0xF0, 0xE0, 0x06}); // LD A, 0xF0; LDH (TMA), A
+    gen.Emit({0x3E, 0x05, 0xE0, 0x07}); // LD A, 0x05; LDH (TAC), A
+    gen.Emit({0x3E, 0x04, 0xE0, 0xFF}); // LD A, Timer; LDH (IE), A
+    gen.Emit({0xAF, 0xE0, 0x0F});   // XOR A; LDH (IF), A
+    gen.Emit({0xFB});               // EI
+
+    uint16_t loop = gen.Address();
+
+    while (gen.code.size() < 0x3000) {
+      auto pick = gen.Random(16);
+
+      if (pick < 11) {
+        gen.Native();
+      } else if (pick < 13) {
+        gen.Jump();
+      } else {
+        gen.Handler();
+      }
+    }
+
+    gen.Emit16(0xC3, loop);
+
+    // Plain 32k ROM
+    rom.Program(Origin, gen.code);
+
+    return rom.Write("hijo-jit-test.gb");
+  }
+
+  struct Snapshot {
+    std::array<uint16_t, 6> regs{};
+    uint64_t instructions = 0;
+    uint64_t cycles = 0;
+    std::vector<uint8_t> wram;
+  };
+
+  Snapshot Run(const std::string &path, bool jit, bool lockstep) {
+    auto &gb = Gameboy::Get();
+    auto &cpu = gb.Cpu();
+
+    cpu.UseBlockCache(false);
+    cpu.UseJit(jit);
+    cpu.UseJitLockstep(lockstep);
+
+    EventManager::Dispatcher().trigger(Events::LoadROM{path});
+
+    for (int frame = 0; frame < Frames; frame++) {
+      gb.Update(Timestep);
+    }
+
+    Snapshot snapshot;
+    snapshot.regs = {cpu.Reg(Register::AF), cpu.Reg(Register::BC), cpu.Reg(Register::DE),
+                     cpu.Reg(Register::HL), cpu.Reg(Register::SP), cpu.Reg(Register::PC)};
+    snapshot.instructions = cpu.InstructionCount();
+    snapshot.cycles = gb.TotalCycles();
+
+    for (uint32_t addr = 0xC000; addr < 0xE000; addr++) {
+      snapshot.wram.push_back(gb.cpuRead(static_cast<uint16_t>(addr)));
+    }
+
+    return snapshot;
+  }
+
+  void Same(const Snapshot &actual, const Snapshot &expected) {
+    for (size_t i = 0; i < expected.regs.size(); i++) {
+      CHECK_EQ(actual.regs[i], expected.regs[i]);
+    }
+
+    CHECK_EQ(actual.instructions, expected.instructions);
+    CHECK_EQ(actual.cycles, expected.cycles);
+    CHECK(actual.wram == expected.wram);
+  }
+}
+
+int main() {
+  if (!Jit::Supported()) {
+    return hijo::test::Result("hijo-jit-test");
+  }
+
+  auto path = MakeRom();
+  auto &gb = Gameboy::Get();
+  const auto &stats = gb.Cpu().JitStats();
+
+  auto interpreted = Run(path, false, false);
+
+  // The program ran, took interrupts and logged into WRAM
+  CHECK(interpreted.instructions > 100000);
+  CHECK(std::any_of(interpreted.wram.begin(), interpreted.wram.begin() + LogSize, [](uint8_t b) { return b != 0; }));
+
+  auto compiled = Run(path, true, false);
+  Same(compiled, interpreted);
+  CHECK(stats.compiled > 0);
+  CHECK(stats.executions > 0);
+  CHECK(stats.nativeInstructions * 2 > stats.instructions);
+
+  auto lockstep = Run(path, true, true);
+  Same(lockstep, interpreted);
+  CHECK(stats.lockstepChecks > 0);
+  CHECK_EQ(stats.divergences, uint64_t{0});
+
+  std::filesystem::remove(path);
+
+  return hijo::test::Result("hijo-jit-test");
+}
@@ -0,0 +1,357 @@
+#include <random>
+#include <vector>
+
+#include "system/Gameboy.h"
+#include "system/Scheduler.h"
+#include "cpu/Timer.h"
+#include "tests/Check.h"
+
+/*
+ * hijo-timer-test: runs the closed-form Timer next to a copy of the old
+ * per-T-cycle implementation and checks that DIV, TIMA, the Timer
+ * interrupt and the predicted overflow cycle agree, edge cases first.
+ */
+
+namespace {
+  using namespace hijo;
+
+  constexpr uint8_t TimerBit = 0x04;
+
+  // TAC select to T-cycles between TIMA increments
+  constexpr uint32_t Periods[] = {1024, 16, 64, 256};
+
+  // The timer as it was before it went lazy: DIV counts T-cycles and TIMA
+  // counts falling edges of the selected DIV bit, reloading from TMA as
+  // soon as it reaches 0xFF
+  struct Reference {
+    uint16_t div = 0;
+    uint8_t tima = 0;
+    uint8_t tma = 0;
+    uint8_t tac = 0;
+
+    uint64_t now = 0;
+    std::vector<uint64_t> overflows;
+
+    void Tick() {
+      static constexpr uint8_t bits[] = {9, 3, 5, 7};
+
+      uint16_t prev = div;
+      div++;
+      now++;
+
+      if ((tac & 0x4) == 0) {
+        return;
+      }
+
+      uint8_t bit = bits[tac & 0x3];
+
+      if ((prev & (1 << bit)) && !(div & (1 << bit))) {
+        tima++;
+
+        if (tima == 0xFF) {
+          tima = tma;
+          overflows.push_back(now);
+        }
+      }
+    }
+
+    void Advance(uint64_t target) {
+      while (now < target) {
+        Tick();
+      }
+    }
+
+    void Write(uint16_t address, uint8_t value) {
+      switch (address) {
+        case 0xFF04:
+          div = 0;
+          break;
+        case 0xFF05:
+          tima = value;
+          break;
+        case 0xFF06:
+          tma = value;
+          break;
+        case 0xFF07:
+          tac = value;
+          break;
+      }
+    }
+  };
+
+  // Both timers side by side. The Timer's own Read/Write catch up to the
+  // bus clock, which never moves here, so every step catches up explicitly.
+  struct Pair {
+    Timer timer;
+    Reference reference;
+    uint64_t now = 0;
+
+    Pair(uint8_t tac, uint8_t tima = 0, uint8_t tma = 0) {
+      Set(0xFF07, tac);
+      Set(0xFF05, tima);
+      Set(0xFF06, tma);
+      ClearIrq();
+    }
+
+    void Advance(uint64_t cycles) {
+      now += cycles;
+      timer.CatchUp(now);
+      reference.Advance(now);
+    }
+
+    void Set(uint16_t address, uint8_t value) {
+      timer.Write(address, value);
+      reference.Write(address, value);
+    }
+
+    static bool Irq() {
+      return Gameboy::Get().Cpu().IntFlags() & TimerBit;
+    }
+
+    static void ClearIrq() {
+      auto &cpu = Gameboy::Get().Cpu();
+      cpu.IntFlags(cpu.IntFlags() & ~TimerBit);
+    }
+
+    // Registers match and the Timer raised the interrupt exactly when the
+    // reference overflowed since the last call
+    void Agree(const char *file, int line) {
+      bool expectIrq = !reference.overflows.empty();
+
+      if (timer.div != reference.div || timer.tima != reference.tima || Irq() != expectIrq) {
+        test::Fail(file, line, fmt::format(
+            "at {}: div {:04X}/{:04X} tima {:02X}/{:02X} irq {}/{} (timer/reference)",
+            now, timer.div, reference.div, timer.tima, reference.tima, Irq(), expectIrq));
+      }
+
+      reference.overflows.clear();
+      ClearIrq();
+    }
+  };
+
+#define AGREE(pair) (pair).Agree(__FILE__, __LINE__)
+
+  // Resetting DIV while the selected bit is high doesn't count as an edge
+  void DivResetFallingEdge() {
+    for (uint8_t select = 0; select < 4; select++) {
+      uint32_t period = Periods[select];
+      Pair pair(0x4 | select, 0x10);
+
+      // Selected bit is high from period / 2 to period - 1
+      pair.Advance(period - 1);
+      AGREE(pair);
+      CHECK_EQ(pair.timer.tima, 0x10);
+
+      pair.Set(0xFF04, 0);
+      CHECK_EQ(pair.timer.div, 0);
+
+      pair.Advance(period - 1);
+      AGREE(pair);
+      CHECK_EQ(pair.timer.tima, 0x10);
+
+      pair.Advance(1);
+      AGREE(pair);
+      CHECK_EQ(pair.timer.tima, 0x11);
+
+      // A reset in the low half just restarts the period
+      pair.Advance(period / 4);
+      pair.Set(0xFF04, 0);
+      pair.Advance(period);
+      AGREE(pair);
+      CHECK_EQ(pair.timer.tima, 0x12);
+    }
+  }
+
+  // Switching the selected bit or the enable doesn't count as an edge, and
+  // a disabled timer still runs DIV
+  void TacChanges() {
+    // Bit 3 high at DIV 8-15, bit 5 low there
+    Pair select(0x05, 0x20);
+    select.Advance(12);
+    select.Set(0xFF07, 0x06);
+    AGREE(select);
+    CHECK_EQ(select.timer.tima, 0x20);
+
+    select.Advance(64 - 12);
+    AGREE(select);
+    CHECK_EQ(select.timer.tima, 0x21);
+
+    // At DIV 72 bit 5 is low and bit 3 high
+    Pair low(0x06, 0x20);
+    low.Advance(64 + 8);
+    low.Set(0xFF07, 0x05);
+    AGREE(low);
+    CHECK_EQ(low.timer.tima, 0x21);
+
+    low.Advance(8);
+    AGREE(low);
+    CHECK_EQ(low.timer.tima, 0x22);
+
+    // Disable while the bit is high, run for a while, enable again
+    Pair enable(0x05, 0x30);
+    enable.Advance(12);
+    enable.Set(0xFF07, 0x01);
+    CHECK_EQ(enable.timer.NextOverflow(), Scheduler::Never);
+    CHECK_EQ(enable.timer.NextChange(0xFF05), Scheduler::Never);
+
+    enable.Advance(16 * 40 + 2);
+    AGREE(enable);
+    CHECK_EQ(enable.timer.tima, 0x30);
+    CHECK_EQ(enable.timer.div, 16 * 40 + 14);
+
+    enable.Set(0xFF07, 0x05);
+    enable.Advance(1);
+    AGREE(enable);
+    CHECK_EQ(enable.timer.tima, 0x30);
+
+    enable.Advance(1);
+    AGREE(enable);
+    CHECK_EQ(enable.timer.tima, 0x31);
+
+    // Every select change in every phase of the period
+    for (uint8_t from = 0; from < 8; from++) {
+      for (uint8_t to = 0; to < 8; to++) {
+        for (uint32_t phase = 0; phase < 1024; phase += 7) {
+          Pair pair(from, 0x40);
+          pair.Advance(phase);
+          pair.Set(0xFF07, to);
+          pair.Advance(2048);
+          AGREE(pair);
+        }
+      }
+    }
+  }
+
+  // TIMA written as 0xFF counts through 0x00 without an interrupt, and a
+  // TMA of 0xFF reloads to 0xFF so every reload period is 256 edges
+  void ReloadsAtFF() {
+    Pair tima(0x05, 0xFF, 0x00);
+    tima.Advance(16);
+    AGREE(tima);
+    CHECK_EQ(tima.timer.tima, 0x00);
+
+    tima.Advance(16 * 0xFE);
+    AGREE(tima);
+    CHECK_EQ(tima.timer.tima, 0xFE);
+
+    tima.Advance(16);
+    CHECK(Pair::Irq());
+    AGREE(tima);
+    CHECK_EQ(tima.timer.tima, 0x00);
+
+    Pair tma(0x05, 0xFE, 0xFF);
+    tma.Advance(16);
+    CHECK(Pair::Irq());
+    AGREE(tma);
+    CHECK_EQ(tma.timer.tima, 0xFF);
+
+    tma.Advance(16);
+    AGREE(tma);
+    CHECK_EQ(tma.timer.tima, 0x00);
+
+    CHECK_EQ(tma.timer.NextOverflow(), tma.now + 16 * 0xFF);
+
+    tma.Advance(16 * 0xFE);
+    AGREE(tma);
+    CHECK_EQ(tma.timer.tima, 0xFE);
+
+    tma.Advance(16);
+    CHECK(Pair::Irq());
+    AGREE(tma);
+    CHECK_EQ(tma.timer.tima, 0xFF);
+  }
+
+  // One catch-up spanning many overflows lands where ticking would have
+  void MultiOverflowCatchUp() {
+    for (uint8_t select = 0; select < 4; select++) {
+      for (uint8_t tma: {0x00, 0x80, 0xF0, 0xFE, 0xFF}) {
+        Pair pair(0x4 | select, 0xF0, tma);
+
+        pair.Advance(Periods[select] * 1000 + 3);
+        CHECK(pair.reference.overflows.size() > 1);
+        AGREE(pair);
+
+        pair.Advance(Periods[select] * 777);
+        AGREE(pair);
+      }
+    }
+  }
+
+  // NextOverflow names the exact cycle the interrupt is raised in
+  void NextOverflowExact() {
+    for (uint8_t select = 0; select < 4; select++) {
+      for (uint8_t tima: {0x00, 0x7F, 0xFD, 0xFE, 0xFF}) {
+        for (uint32_t phase: {0u, 1u, Periods[select] / 2, Periods[select] - 1}) {
+          Pair pair(0x4 | select, 0x00, 0x80);
+          pair.Advance(phase);
+          pair.Set(0xFF05, tima);
+
+          uint64_t overflow = pair.timer.NextOverflow();
+
+          CHECK(overflow > pair.now);
+
+          pair.Advance(overflow - 1 - pair.now);
+          CHECK(!Pair::Irq());
+          AGREE(pair);
+
+          pair.Advance(1);
+          CHECK(Pair::Irq());
+          CHECK(!pair.reference.overflows.empty() && pair.reference.overflows.front() == overflow);
+          AGREE(pair);
+
+          // And again from the reload
+          CHECK_EQ(pair.timer.NextOverflow(), overflow + Periods[select] * (0xFF - 0x80));
+        }
+      }
+    }
+  }
+
+  // A reset stops the timer, nothing of the last game's setup survives it
+  void ResetClearsRegisters() {
+    Pair pair(0x05, 0xFE, 0xF0);
+
+    pair.Advance(8);
+    pair.timer.Reset();
+
+    CHECK_EQ(pair.timer.tma, 0);
+    CHECK_EQ(pair.timer.tac, 0);
+    CHECK_EQ(pair.timer.tima, 0);
+
+    pair.timer.CatchUp(1024);
+    CHECK_EQ(pair.timer.tima, 0);
+    CHECK(!Pair::Irq());
+  }
+
+  // Random register writes between random advances
+  void Randomized() {
+    std::mt19937 rng(0x54494D41);
+    Pair pair(0x05);
+
+    for (int i = 0; i < 20000; i++) {
+      uint32_t op = rng() % 8;
+
+      if (op < 4) {
+        pair.Advance(rng() % (op == 0 ? 70000 : 300));
+      } else {
+        pair.Set(0xFF04 + (op - 4), static_cast<uint8_t>(rng()));
+      }
+
+      AGREE(pair);
+    }
+  }
+}
+
+int main() {
+  // Touch the bus first so its logger and registers exist
+  Gameboy::Get();
+
+  DivResetFallingEdge();
+  TacChanges();
+  ReloadsAtFF();
+  MultiOverflowCatchUp();
+  NextOverflowExact();
+  ResetClearsRegisters();
+  Randomized();
+
+  return hijo::test::Result("hijo-timer-test");
+}